@@ -22,11 +22,30 @@
 #pragma warning(disable:4996) 
 
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <vector>
 #include <variant>
 #include <optional>
-#include <regex>
+#include <cstring>
 #include <cmath>
+#include <type_traits>
+
+// SIMD instructions are used to find group boundaries in report if available;
+// define METAF_NO_SIMD to always use scalar code
+#if !defined(METAF_NO_SIMD)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define METAF_SIMD_SSE2
+		#include <emmintrin.h>
+	#endif
+	#if defined(__AVX2__)
+		#define METAF_SIMD_AVX2
+		#include <immintrin.h>
+	#endif
+	#if defined(METAF_SIMD_SSE2) && defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+	#endif
+#endif
 
 namespace metaf {
 
@@ -88,6 +107,42 @@ using Group = std::variant<
 
 ///////////////////////////////////////////////////////////////////////////
 
+// Array which holds up to maxSize elements. First inlineSize elements are
+// stored within the object itself; the remaining ones are rarely needed
+// and are stored in the heap. This allows groups such as WeatherGroup to
+// hold long sequences of weather events without making every Group large.
+template <typename T, std::size_t inlineSize, std::size_t maxSize>
+class CompactArray {
+public:
+	std::size_t size() const { return inlineCount + extra.size(); }
+	bool push_back(const T & value) {
+		if (size() >= maxSize) return false;
+		if (inlineCount < inlineSize) {
+			inlineData[inlineCount++] = value;
+			return true;
+		}
+		extra.push_back(value);
+		return true;
+	}
+	const T & operator[](std::size_t index) const {
+		if (index < inlineSize) return inlineData[index];
+		return extra[index - inlineSize];
+	}
+	T & operator[](std::size_t index) {
+		if (index < inlineSize) return inlineData[index];
+		return extra[index - inlineSize];
+	}
+
+private:
+	static_assert(inlineSize <= maxSize, "Inline storage exceeds max size");
+	static_assert(inlineSize < 0xFF, "Inline storage too large");
+	std::uint8_t inlineCount = 0;
+	T inlineData[inlineSize];
+	std::vector<T> extra;
+};
+
+///////////////////////////////////////////////////////////////////////////
+
 class Runway {
 public:
 	enum class Designator {
@@ -111,7 +166,7 @@ public:
 	}
 
 	Runway() = default;
-	static inline std::optional<Runway> fromString(const std::string & s, bool enableRwy = false);
+	static inline std::optional<Runway> fromString(std::string_view s, bool enableRwy = false);
 	static Runway makeAllRunways() {
 		Runway rw;
 		rw.rNumber = allRunwaysNumber;
@@ -137,7 +192,10 @@ public:
 		unsigned int month;
 		unsigned int day;
 	};
-	std::optional<unsigned int> day() const { return dayValue; }
+	std::optional<unsigned int> day() const {
+		if (dayValue == dayNotSpecified) return std::optional<unsigned int>();
+		return dayValue;
+	}
 	unsigned int hour() const { return hourValue; }
 	unsigned int minute() const { return minuteValue; }
 	inline bool isValid() const;
@@ -147,18 +205,31 @@ public:
 
 	MetafTime() = default;
 	MetafTime(unsigned int hour, unsigned int minute) :
-		hourValue(hour), minuteValue(minute) {}
+		hourValue(pack(hour)), minuteValue(pack(minute)) {}
 	MetafTime(std::optional<unsigned int> day, 
 		unsigned int hour, 
 		unsigned int minute) :
-			dayValue(day), hourValue(hour), minuteValue(minute) {}
-	static inline std::optional<MetafTime> fromStringDDHHMM(const std::string & s);
-	static inline std::optional<MetafTime> fromStringDDHH(const std::string & s);
+			dayValue(packDay(day)), hourValue(pack(hour)), minuteValue(pack(minute)) {}
+	static inline std::optional<MetafTime> fromStringDDHHMM(std::string_view s);
+	static inline std::optional<MetafTime> fromStringDDHH(std::string_view s);
 
 private:
-	std::optional<unsigned int> dayValue;
-	unsigned int hourValue = 0;
-	unsigned int minuteValue = 0;
+	// Day, hour and minute are stored in one byte each to keep MetafTime
+	// (and groups which store time) small. All values decoded from reports
+	// are two-digit; values which do not fit are saturated to outOfRange
+	// which is still recognised as invalid by isValid().
+	std::uint8_t dayValue = dayNotSpecified;
+	std::uint8_t hourValue = 0;
+	std::uint8_t minuteValue = 0;
+
+	static const inline std::uint8_t dayNotSpecified = 0xFF;
+	static const inline std::uint8_t outOfRange = 0xFE;
+	static std::uint8_t pack(unsigned int value) {
+		return (value < outOfRange) ? static_cast<std::uint8_t>(value) : outOfRange;
+	}
+	static std::uint8_t packDay(std::optional<unsigned int> day) {
+		return day.has_value() ? pack(*day) : dayNotSpecified;
+	}
 
 	static const inline unsigned int dayNotReported = 0;
 	static const inline unsigned int maxDay = 31;
@@ -195,8 +266,8 @@ public:
 		const Speed & windSpeed);
 
 	Temperature () = default;
-	static inline std::optional<Temperature> fromString(const std::string & s);
-	static inline std::optional<Temperature> fromRemarkString(const std::string & s);
+	static inline std::optional<Temperature> fromString(std::string_view s);
+	static inline std::optional<Temperature> fromRemarkString(std::string_view s);
 private:
 	inline Temperature (float value);
 
@@ -221,8 +292,8 @@ public:
 	bool isReported() const { return speedValue.has_value(); }
 
 	Speed() = default;
-	static inline std::optional<Speed> fromString(const std::string & s, Unit unit);
-	static inline std::optional<Unit> unitFromString(const std::string & s);
+	static inline std::optional<Speed> fromString(std::string_view s, Unit unit);
+	static inline std::optional<Unit> unitFromString(std::string_view s);
 
 private:
 	std::optional<unsigned int> speedValue;
@@ -286,15 +357,15 @@ public:
 	Distance(Unit u) : distUnit(u) {}
 	static inline std::optional<Distance> fromIntegerAndFraction(const Distance & integer,
 		const Distance & fraction);
-	static inline std::optional<Distance> fromMeterString(const std::string & s);
-	static inline std::optional<Distance> fromMileString(const std::string & s,
+	static inline std::optional<Distance> fromMeterString(std::string_view s);
+	static inline std::optional<Distance> fromMileString(std::string_view s,
 		bool remarkFormat = false);
-	static inline std::optional<Distance> fromHeightString(const std::string & s);
-	static inline std::optional<Distance> fromRvrString(const std::string & s, bool unitFeet);
+	static inline std::optional<Distance> fromHeightString(std::string_view s);
+	static inline std::optional<Distance> fromRvrString(std::string_view s, bool unitFeet);
 	static inline std::optional< std::pair<Distance,Distance> > fromLayerString(
-		const std::string & s);
+		std::string_view s);
 	static inline Distance cavokVisibility(bool unitMiles = false);
-	static inline std::optional<Distance> fromKmString(const std::string & s);
+	static inline std::optional<Distance> fromKmString(std::string_view s);
 	static inline Distance makeDistant();
 	static inline Distance makeVicinity();
 private:
@@ -372,12 +443,12 @@ public:
 	static inline Cardinal rotateOctantClockwise(Cardinal cardinal);
 
 	Direction() = default;
-	static inline std::optional<Direction> fromCardinalString(const std::string & s,
+	static inline std::optional<Direction> fromCardinalString(std::string_view s,
 		bool enableOhdAlqds = false,
 		bool enableUnknown = false);
-	static inline std::optional<Direction> fromDegreesString(const std::string & s);
+	static inline std::optional<Direction> fromDegreesString(std::string_view s);
 	static inline std::optional<std::pair<Direction, Direction>> fromSectorString(
-		const std::string & s);
+		std::string_view s);
 
 private:
 	unsigned int dirDegrees = 0;
@@ -410,11 +481,11 @@ public:
 	bool isReported() const { return pressureValue.has_value(); }
 
 	Pressure() = default;
-	static inline std::optional<Pressure> fromString(const std::string & s);
-	static inline std::optional<Pressure> fromForecastString(const std::string & s);
-	static inline std::optional<Pressure> fromSlpString(const std::string & s);
-	static inline std::optional<Pressure> fromQfeString(const std::string & s);
-	static inline std::optional<Pressure> fromTendencyString(const std::string & s);
+	static inline std::optional<Pressure> fromString(std::string_view s);
+	static inline std::optional<Pressure> fromForecastString(std::string_view s);
+	static inline std::optional<Pressure> fromSlpString(std::string_view s);
+	static inline std::optional<Pressure> fromQfeString(std::string_view s);
+	static inline std::optional<Pressure> fromTendencyString(std::string_view s);
 
 private:
 	std::optional<float> pressureValue;
@@ -436,14 +507,14 @@ public:
 	bool isReported() const { return precipValue.has_value(); }
 
 	Precipitation() = default;
-	static inline std::optional<Precipitation> fromRainfallString(const std::string & s);
-	static inline std::optional<Precipitation> fromRunwayDeposits(const std::string & s);
-	static inline std::optional<Precipitation> fromRemarkString(const std::string & s,
+	static inline std::optional<Precipitation> fromRainfallString(std::string_view s);
+	static inline std::optional<Precipitation> fromRunwayDeposits(std::string_view s);
+	static inline std::optional<Precipitation> fromRemarkString(std::string_view s,
 		float factor = 1,
 		Unit unit = Unit::INCHES, 
 		bool allowNotReported = false);
 	static inline std::optional<std::pair<Precipitation, Precipitation> >
-		fromSnincrString(const std::string & s);
+		fromSnincrString(std::string_view s);
 
 private:
 	std::optional<float> precipValue;
@@ -490,7 +561,7 @@ public:
 	bool isUnreliable() const { return (type() == Type::UNRELIABLE); }
 
 	SurfaceFriction() = default;
-	static inline std::optional<SurfaceFriction> fromString(const std::string & s);
+	static inline std::optional<SurfaceFriction> fromString(std::string_view s);
 
 private:
 	Type sfType = Type::NOT_REPORTED;
@@ -551,7 +622,7 @@ public:
 	inline std::optional<float> toUnit(Unit unit) const;
 
 	WaveHeight() = default;
-	static inline std::optional<WaveHeight> fromString(const std::string & s);
+	static inline std::optional<WaveHeight> fromString(std::string_view s);
 
 private:
 	Type whType = Type::STATE_OF_SURFACE;
@@ -635,10 +706,10 @@ public:
 	inline bool isValid() const;
 
 	WeatherPhenomena() = default;
-	static inline std::optional <WeatherPhenomena> fromString(const std::string & s,
+	static inline std::optional <WeatherPhenomena> fromString(std::string_view s,
 		bool enableQualifiers = false);
 	static inline std::optional <WeatherPhenomena> fromWeatherBeginEndString(
-		const std::string & s,
+		std::string_view s,
 		const MetafTime & reportTime,
 		const WeatherPhenomena & previous);
 	static WeatherPhenomena notReported(bool recent) {
@@ -700,6 +771,11 @@ private:
 	static inline bool isDescriptorTsAllowed (Weather w);
 	static inline bool isDescriptorFzAllowed (Weather w);
 
+	size_t weatherCount() const {
+		return ((data >> weatherCountShiftBits) & weatherCountMask);
+	}
+	inline Weather weatherAt(size_t index) const;
+
 	inline static uint32_t pack(Qualifier q = Qualifier::NONE, 
 		Descriptor d = Descriptor::NONE,
 		size_t wNum = 0,
@@ -708,11 +784,6 @@ private:
 		Weather w3 = Weather::NOT_REPORTED,
 		Event e = Event::NONE
 	);
-	inline static uint32_t pack(Qualifier q, 
-		Descriptor d,
-		std::vector<Weather> w,
-		Event e = Event::NONE
-	);
 
 	// The following is to confirm that all enums cast to unsigned int
 	// fit into the specified amount of bits
@@ -808,15 +879,15 @@ public:
 
 	CloudType() = default;
 	CloudType(Type t, Distance h, unsigned int o) : tp(t), ht(h), okt(o) {}
-	static inline std::optional<CloudType> fromString(const std::string & s);
-	static inline std::optional<CloudType> fromStringObscuration(const std::string & s);
+	static inline std::optional<CloudType> fromString(std::string_view s);
+	static inline std::optional<CloudType> fromStringObscuration(std::string_view s);
 private:
 	Type tp = Type::NOT_REPORTED;
 	Distance ht;
 	unsigned int okt = 0u;
 
-	static inline Type cloudTypeFromString(const std::string & s);
-	static inline Type cloudTypeOrObscurationFromString(const std::string & s);
+	static inline Type cloudTypeFromString(std::string_view s);
+	static inline Type cloudTypeOrObscurationFromString(std::string_view s);
 };
 
 ///////////////////////////////////////////////////////////////////////////
@@ -904,6 +975,37 @@ enum class AppendResult {
 
 ///////////////////////////////////////////////////////////////////////////
 
+// Group signature is a coarse description of strings which the group's
+// parse() may be able to recognise: report parts, allowed first chars and
+// the range of the group string's length.
+// Signatures are only used by GroupParser to skip alternatives which
+// cannot possibly match, therefore signature must never be narrower than
+// what parse() actually accepts.
+// Each group class lists its signatures in static member 'signatures'.
+struct GroupSignature {
+	enum CharClass : unsigned int {
+		NO_CLASS = 0,
+		DIGITS = 1, // Any char '0' to '9'
+		LETTERS = 2 // Any char 'A' to 'Z'
+	};
+	static const inline auto anyLength = std::size_t(-1);
+
+	unsigned int reportParts; // Bit mask, see reportPartMask()
+	unsigned int firstCharClasses; // Bit mask of CharClass
+	const char * firstChars; // Other allowed first chars
+	std::size_t minLength;
+	std::size_t maxLength;
+};
+
+static const inline unsigned int allReportParts = ~0u;
+
+template <typename... R>
+constexpr unsigned int reportPartMask(R... reportParts) {
+	return ((1u << static_cast<unsigned int>(reportParts)) | ...);
+}
+
+///////////////////////////////////////////////////////////////////////////
+
 // Default delimiter between groups
 // Note: only used to append raw strings, see also groupDelimiterRegex
 static const inline char groupDelimiterChar = ' ';
@@ -942,10 +1044,17 @@ public:
 	bool isValid() const { return (true); }
 
 	KeywordGroup() = default;
-	static inline std::optional<KeywordGroup> parse(const std::string & group,
+	static inline std::optional<KeywordGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::HEADER), GroupSignature::NO_CLASS, "MSTACN", 3, 5},
+		{reportPartMask(ReportPart::METAR), GroupSignature::NO_CLASS, "CNAR", 3, 5},
+		{reportPartMask(ReportPart::TAF), GroupSignature::NO_CLASS, "CNR", 3, 5},
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "AN", 3, 7},
+		{allReportParts, GroupSignature::NO_CLASS, "$", 1, 1}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -960,10 +1069,13 @@ public:
 	inline bool isValid() const { return true; }
 
 	LocationGroup() = default;
-	static inline std::optional<LocationGroup> parse(const std::string & group,
+	static inline std::optional<LocationGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::HEADER), GroupSignature::LETTERS, "", 4, 4}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -979,10 +1091,13 @@ public:
 
 	ReportTimeGroup() = default;
 	static inline std::optional<ReportTimeGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::HEADER), GroupSignature::DIGITS, "", 7, 7}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1024,10 +1139,18 @@ public:
 
 	TrendGroup() = default;
 	static inline std::optional<TrendGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::METAR, ReportPart::TAF), GroupSignature::NO_CLASS, "BTI", 5, 5},
+		{reportPartMask(ReportPart::TAF), GroupSignature::NO_CLASS, "P", 6, 6},
+		{reportPartMask(ReportPart::HEADER, ReportPart::METAR, ReportPart::TAF), GroupSignature::DIGITS, "", 9, 9},
+		{reportPartMask(ReportPart::TAF), GroupSignature::NO_CLASS, "F", 8, 8},
+		{reportPartMask(ReportPart::METAR), GroupSignature::NO_CLASS, "N", 5, 5},
+		{reportPartMask(ReportPart::METAR), GroupSignature::NO_CLASS, "FTA", 6, 6}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1035,10 +1158,10 @@ private:
 	TrendGroup(Type type) : t(type) {}
 	TrendGroup(Probability p) : t(Type::PROB), prob(p) {}
 
-	static inline std::optional<TrendGroup> fromTimeSpan(const std::string & s);
-	static inline std::optional<TrendGroup> fromTimeSpanHHMM(const std::string & s);
-	static inline std::optional<TrendGroup> fromFm(const std::string & s);
-	static inline std::optional<TrendGroup> fromTrendTime(const std::string & s);
+	static inline std::optional<TrendGroup> fromTimeSpan(std::string_view s);
+	static inline std::optional<TrendGroup> fromTimeSpanHHMM(std::string_view s);
+	static inline std::optional<TrendGroup> fromFm(std::string_view s);
+	static inline std::optional<TrendGroup> fromTrendTime(std::string_view s);
 
 	inline bool combineProbAndTrendTypeGroups(const TrendGroup & nextTrendGroup);
 	inline bool combineTrendTypeAndTimeGroup(const TrendGroup & nextTrendGroup);
@@ -1088,10 +1211,14 @@ public:
 
 	WindGroup() = default;
 	static inline std::optional<WindGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::METAR, ReportPart::TAF), GroupSignature::DIGITS, "/VW", 2, 19},
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "WP", 2, 5}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 private:
@@ -1106,12 +1233,12 @@ private:
 	WindGroup(Type type, IncompleteText incomplete = IncompleteText::NONE) :
 		windType(type), incompleteText(incomplete) {}
 	static inline std::optional<WindGroup> parseVariableSector(
-		const std::string & group);
-	inline AppendResult appendPeakWind(const std::string & group,
+		std::string_view group);
+	inline AppendResult appendPeakWind(std::string_view group,
 		const ReportMetadata & reportMetadata);
-	inline AppendResult appendWindShift(const std::string & group,
+	inline AppendResult appendWindShift(std::string_view group,
 		const ReportMetadata & reportMetadata);
-	inline AppendResult appendVariableSector(const std::string & group);
+	inline AppendResult appendVariableSector(std::string_view group);
 
 	Type windType;
 	Direction windDir;
@@ -1177,10 +1304,15 @@ public:
 
 	VisibilityGroup() = default;
 	inline static std::optional<VisibilityGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::METAR, ReportPart::TAF), GroupSignature::DIGITS, "/PM", 1, 8},
+		{reportPartMask(ReportPart::METAR), GroupSignature::NO_CLASS, "R", 8, 20},
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "VSTR", 3, 5}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 private:
@@ -1226,31 +1358,31 @@ private:
 		}
 	}
 
-	static inline std::optional<VisibilityGroup> fromIncompleteInteger(const std::string & group);
-	static inline std::optional<VisibilityGroup> fromMeters(const std::string & group);
-	static inline std::optional<VisibilityGroup> fromRvr(const std::string & group);
+	static inline std::optional<VisibilityGroup> fromIncompleteInteger(std::string_view group);
+	static inline std::optional<VisibilityGroup> fromMeters(std::string_view group);
+	static inline std::optional<VisibilityGroup> fromRvr(std::string_view group);
 
-	inline bool appendFractionToIncompleteInteger(const std::string & group, 
+	inline bool appendFractionToIncompleteInteger(std::string_view group, 
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendDirection(const std::string & group, 
+	inline bool appendDirection(std::string_view group, 
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendRunway(const std::string & group, 
+	inline bool appendRunway(std::string_view group, 
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendInteger(const std::string & group, 
+	inline bool appendInteger(std::string_view group, 
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendFraction(const std::string & group, 
+	inline bool appendFraction(std::string_view group, 
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendVariable(const std::string & group, 
+	inline bool appendVariable(std::string_view group, 
 		IncompleteText nextIfMaxIsInteger = IncompleteText::NONE,
 		IncompleteText nextIfMaxIsFraction = IncompleteText::NONE);
-	inline bool appendVariableMaxFraction(const std::string & group,
+	inline bool appendVariableMaxFraction(std::string_view group,
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendMeters(const std::string & group, 
+	inline bool appendMeters(std::string_view group, 
 		IncompleteText next = IncompleteText::NONE);
-	inline bool appendVariableMeters(const std::string & group, 
+	inline bool appendVariableMeters(std::string_view group, 
 		IncompleteText next = IncompleteText::NONE);
 
-	static inline Trend trendFromString(const std::string & s);
+	static inline Trend trendFromString(std::string_view s);
 
 	Type visType = Type::PREVAILING;
 	Distance vis;
@@ -1329,10 +1461,14 @@ public:
 
 	CloudGroup () = default;
 	static inline std::optional<CloudGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::METAR, ReportPart::TAF), GroupSignature::LETTERS, "/", 3, 9},
+		{reportPartMask(ReportPart::RMK), GroupSignature::LETTERS, "", 2, 6}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 private:
@@ -1361,14 +1497,14 @@ private:
 
 	CloudGroup(Type t, IncompleteText it) : tp(t), incompleteText(it) {}
 	CloudGroup(Type t, Amount a = Amount::NOT_REPORTED) : tp(t), amnt(a) {}
-	static inline std::optional<CloudGroup> parseCloudLayerOrVertVis(const std::string & s);
-	static inline std::optional<CloudGroup> parseVariableCloudLayer(const std::string & s);
-	static inline std::optional<Amount> amountFromString(const std::string & s);
-	static inline std::optional<ConvectiveType> convectiveTypeFromString(const std::string & s);
-	inline AppendResult appendVariableCloudAmount(const std::string & group);
-	inline AppendResult appendCeiling(const std::string & group);
-	inline AppendResult appendRunwayOrCardinalDirection(const std::string & group);
-	inline AppendResult appendObscuration(const std::string & group);
+	static inline std::optional<CloudGroup> parseCloudLayerOrVertVis(std::string_view s);
+	static inline std::optional<CloudGroup> parseVariableCloudLayer(std::string_view s);
+	static inline std::optional<Amount> amountFromString(std::string_view s);
+	static inline std::optional<ConvectiveType> convectiveTypeFromString(std::string_view s);
+	inline AppendResult appendVariableCloudAmount(std::string_view group);
+	inline AppendResult appendCeiling(std::string_view group);
+	inline AppendResult appendRunwayOrCardinalDirection(std::string_view group);
+	inline AppendResult appendObscuration(std::string_view group);
 	static inline unsigned int amountToMaxOkta(Amount a);
 	static inline CloudType::Type convectiveTypeToCloudTypeType(ConvectiveType t);
 };
@@ -1389,17 +1525,21 @@ public:
 	inline std::vector<WeatherPhenomena> weatherPhenomena() const;
 	bool isValid() const {
 		if (incompleteText != IncompleteText::NONE) return false;
-		for (auto i=0u; i < wsz; i++) 
+		for (auto i=0u; i < w.size(); i++) 
 			if (!w[i].isValid()) return false;
 		return true;
 	}
 
 	WeatherGroup() = default;
 	static inline std::optional<WeatherGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::METAR, ReportPart::TAF), GroupSignature::LETTERS, "+-/", 2, GroupSignature::anyLength},
+		{reportPartMask(ReportPart::RMK), GroupSignature::LETTERS, "", 2, GroupSignature::anyLength}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1414,9 +1554,11 @@ private:
 	inline bool addWeatherPhenomena(const WeatherPhenomena & wp);
 
 	Type t = Type::CURRENT;
+	// Most weather groups contain one phenomena, sequences of weather
+	// events in remarks may contain more
+	static const inline size_t wInlineSize = 3;
 	static const inline size_t wSize = 20;
-	size_t wsz = 0;
-	WeatherPhenomena w[wSize];
+	CompactArray<WeatherPhenomena, wInlineSize, wSize> w;
 	IncompleteText incompleteText = IncompleteText::NONE;
 
 	WeatherGroup(Type tp, IncompleteText i = IncompleteText::NONE) : t(tp), incompleteText(i) {}
@@ -1424,10 +1566,10 @@ private:
 	static inline WeatherGroup notReportedRecent();
 
 	static inline std::optional<WeatherPhenomena> parseWeatherWithoutEvent(
-		const std::string & group, 
+		std::string_view group, 
 		ReportPart reportPart);
 	static inline std::optional<WeatherGroup> parseWeatherEvent(
-		const std::string & group, 
+		std::string_view group, 
 		const MetafTime & reportTime);
 };
 
@@ -1448,10 +1590,14 @@ public:
 
 	TemperatureGroup() = default;
 	static inline std::optional<TemperatureGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::METAR), GroupSignature::DIGITS, "M/", 3, 7},
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "T", 1, 9}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1480,10 +1626,15 @@ public:
 
 	PressureGroup() = default;
 	static inline std::optional<PressureGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::METAR, ReportPart::RMK), GroupSignature::NO_CLASS, "QA", 5, 5},
+		{reportPartMask(ReportPart::TAF), GroupSignature::NO_CLASS, "Q", 10, 10},
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "SPQ", 4, 11}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1548,10 +1699,13 @@ public:
 
 	RunwayStateGroup() = default;
 	static inline std::optional<RunwayStateGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::METAR), GroupSignature::NO_CLASS, "SR", 5, 11}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1566,8 +1720,8 @@ private:
 	RunwayStateGroup(Type t, Runway r, SurfaceFriction s = SurfaceFriction()) : 
 		rw(r), tp(t), sf(s) {}
 
-	static inline std::optional<Deposits> depositsFromString(const std::string & s);
-	static inline std::optional<Extent> extentFromString(const std::string & s);
+	static inline std::optional<Deposits> depositsFromString(std::string_view s);
+	static inline std::optional<Extent> extentFromString(std::string_view s);
 };
 
 class SeaSurfaceGroup {
@@ -1578,10 +1732,13 @@ public:
 
 	SeaSurfaceGroup() = default;
 	static inline std::optional<SeaSurfaceGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::METAR), GroupSignature::NO_CLASS, "W", 6, 8}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1606,10 +1763,14 @@ public:
 
 	MinMaxTemperatureGroup() = default;
 	static inline std::optional<MinMaxTemperatureGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::TAF), GroupSignature::NO_CLASS, "T", 9, 11},
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "124", 5, 9}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 private:
@@ -1621,14 +1782,14 @@ private:
 	bool isIncomplete = false;
 
 	static inline std::optional<MinMaxTemperatureGroup> from6hourly(
-		const std::string & group);
+		std::string_view group);
 	static inline std::optional<MinMaxTemperatureGroup> from24hourly(
-		const std::string & group);
+		std::string_view group);
 	static inline std::optional<MinMaxTemperatureGroup> fromForecast(
-		const std::string & group);
+		std::string_view group);
 
-	inline AppendResult append6hourly(const std::string & group);
-	inline AppendResult appendForecast(const std::string & group);
+	inline AppendResult append6hourly(std::string_view group);
+	inline AppendResult appendForecast(std::string_view group);
 };
 
 class PrecipitationGroup {
@@ -1659,10 +1820,15 @@ public:
 	bool isValid() const { return !isIncomplete; }
 
 	PrecipitationGroup() = default;
-	static inline std::optional<PrecipitationGroup> parse(const std::string & group,
+	static inline std::optional<PrecipitationGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::METAR), GroupSignature::NO_CLASS, "R", 12, 12},
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "PFIS", 3, 6},
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "P67I49", 5, 6}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 private:
@@ -1707,10 +1873,13 @@ public:
 	bool isValid() const { return true; }
 
 	LayerForecastGroup() = default;
-	static inline std::optional<LayerForecastGroup> parse(const std::string & group,
+	static inline std::optional<LayerForecastGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::TAF), GroupSignature::NO_CLASS, "56", 6, 6}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1719,7 +1888,7 @@ private:
 	Distance layerBaseHeight;
 	Distance layerTopHeight;
 
-	static inline std::optional<Type> typeFromStr(const std::string & s);
+	static inline std::optional<Type> typeFromStr(std::string_view s);
 };
 
 class PressureTendencyGroup {
@@ -1753,10 +1922,13 @@ public:
 
 	PressureTendencyGroup() = default;
 	static inline std::optional<PressureTendencyGroup> parse(
-		const std::string & group,
+		std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "P5", 5, 6}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1773,17 +1945,20 @@ public:
 	inline bool isValid() const;
 
 	CloudTypesGroup() = default;
-	static inline std::optional<CloudTypesGroup> parse(const std::string & group,
+	static inline std::optional<CloudTypesGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::RMK), GroupSignature::DIGITS | GroupSignature::LETTERS, "", 3, GroupSignature::anyLength}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
 private:
-	size_t cldTpSize = 0;
+	inline static const size_t cldTpInlineSize = 2;
 	inline static const size_t cldTpMaxSize = 8;
-	CloudType cldTp[cldTpMaxSize];
+	CompactArray<CloudType, cldTpInlineSize, cldTpMaxSize> cldTp;
 };
 
 class LowMidHighCloudGroup {
@@ -1833,10 +2008,13 @@ public:
 	inline bool isValid() const;
 
 	LowMidHighCloudGroup() = default;
-	static inline std::optional<LowMidHighCloudGroup> parse(const std::string & group,
+	static inline std::optional<LowMidHighCloudGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "8", 5, 5}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1869,10 +2047,13 @@ public:
 	inline bool isValid() const { return !typeUnknown; }
 
 	LightningGroup() = default;
-	static inline std::optional<LightningGroup> parse(const std::string & group,
+	static inline std::optional<LightningGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	inline AppendResult append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "OFCL", 3, GroupSignature::anyLength}
+	};
+	inline AppendResult append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1895,7 +2076,7 @@ private:
 		incomplete = true;
 	}
 	static inline std::optional<LightningGroup> fromLtgGroup(
-		const std::string & group);
+		std::string_view group);
 	bool isOmittedDir1() const { return (!dir1from.has_value() && !dir1to.has_value()); } 
 	bool isOmittedDir2() const { return (!dir2from.has_value() && !dir2to.has_value()); }
 };
@@ -1932,10 +2113,13 @@ public:
 		return (incompleteType == IncompleteType::NONE);
 	}
 
-	static inline std::optional<VicinityGroup> parse(const std::string & group,
+	static inline std::optional<VicinityGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	inline AppendResult append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::RMK), GroupSignature::LETTERS, "", 2, 5}
+	};
+	inline AppendResult append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -1976,9 +2160,9 @@ private:
 		if (type() == Type::ROTOR_CLOUD) incompleteType = IncompleteType::EXPECT_CLD;
 	}
 
-	inline bool appendDir1(const std::string & str);
-	inline bool appendDir2(const std::string & str);
-	inline bool appendDistance(const std::string & str);
+	inline bool appendDir1(std::string_view str);
+	inline bool appendDir2(std::string_view str);
+	inline bool appendDistance(std::string_view str);
 };
 
 class MiscGroup {
@@ -2015,10 +2199,16 @@ public:
 	inline bool isValid() const;
 
 	MiscGroup() = default;
-	static inline std::optional<MiscGroup> parse(const std::string & group,
+	static inline std::optional<MiscGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata);
-	AppendResult inline append(const std::string & group,
+	static constexpr GroupSignature signatures[] = {
+		{reportPartMask(ReportPart::METAR, ReportPart::RMK), GroupSignature::NO_CLASS, "BWGYAR", 3, 9},
+		{reportPartMask(ReportPart::TAF), GroupSignature::NO_CLASS, "F", 7, 7},
+		{reportPartMask(ReportPart::METAR), GroupSignature::NO_CLASS, "C", 3, 3},
+		{reportPartMask(ReportPart::RMK), GroupSignature::NO_CLASS, "GDF9", 2, 7}
+	};
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata);
 
@@ -2035,22 +2225,22 @@ private:
 	std::optional<float> groupData;
 	IncompleteText incompleteText = IncompleteText::NONE;
 
-	inline static std::optional<Type> parseColourCode(const std::string & group);
-	inline bool appendHailstoneFraction (const std::string & group);
-	inline bool appendDensityAltitude (const std::string & group);
+	inline static std::optional<Type> parseColourCode(std::string_view group);
+	inline bool appendHailstoneFraction (std::string_view group);
+	inline bool appendDensityAltitude (std::string_view group);
 };
 
 class UnknownGroup {
 public:
 	UnknownGroup() = default;
-	static std::optional<UnknownGroup> parse(const std::string & group,
+	static std::optional<UnknownGroup> parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata = missingMetadata)
 	{
 		(void)group; (void)reportPart; (void)reportMetadata;
 		return UnknownGroup();
 	}
-	AppendResult inline append(const std::string & group,
+	AppendResult inline append(std::string_view group,
 		ReportPart reportPart = ReportPart::UNKNOWN,
 		const ReportMetadata & reportMetadata = missingMetadata)
 	{
@@ -2062,6 +2252,40 @@ public:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Size budget of each group type. Group variant is as large as its largest
+// alternative and every GroupInfo in ParseResult holds a Group, so any group
+// which grows over budget makes all parse results larger. Large and rarely
+// used data must be stored out of line (see CompactArray).
+// Debug builds of standard library may use larger std::vector, the budget
+// of groups which contain CompactArray is adjusted accordingly.
+static const inline auto vectorDebugOverhead =
+	sizeof(std::vector<int>) - 3 * sizeof(void *);
+static_assert(sizeof(KeywordGroup) <= 8);
+static_assert(sizeof(LocationGroup) <= 8);
+static_assert(sizeof(ReportTimeGroup) <= 4);
+static_assert(sizeof(TrendGroup) <= 24);
+static_assert(sizeof(WindGroup) <= 96);
+static_assert(sizeof(VisibilityGroup) <= 96);
+static_assert(sizeof(CloudGroup) <= 104);
+static_assert(sizeof(WeatherGroup) <= 80 + vectorDebugOverhead);
+static_assert(sizeof(TemperatureGroup) <= 32);
+static_assert(sizeof(PressureGroup) <= 24);
+static_assert(sizeof(RunwayStateGroup) <= 40);
+static_assert(sizeof(SeaSurfaceGroup) <= 24);
+static_assert(sizeof(MinMaxTemperatureGroup) <= 40);
+static_assert(sizeof(PrecipitationGroup) <= 32);
+static_assert(sizeof(LayerForecastGroup) <= 40);
+static_assert(sizeof(PressureTendencyGroup) <= 16);
+static_assert(sizeof(CloudTypesGroup) <= 88 + vectorDebugOverhead);
+static_assert(sizeof(LowMidHighCloudGroup) <= 12);
+static_assert(sizeof(LightningGroup) <= 80);
+static_assert(sizeof(VicinityGroup) <= 80);
+static_assert(sizeof(MiscGroup) <= 16);
+static_assert(sizeof(UnknownGroup) <= 1);
+static_assert(sizeof(Group) <= 112 + vectorDebugOverhead);
+
+///////////////////////////////////////////////////////////////////////////////
+
 struct GroupInfo {
 	GroupInfo(Group g, ReportPart rp, std::string rawstr) :
 		group(std::move(g)), reportPart(rp), rawString(std::move(rawstr)) {}
@@ -2096,47 +2320,125 @@ inline SyntaxGroup getSyntaxGroup(const Group & group);
 
 class GroupParser {
 public:
-	static Group parse(const std::string & group,
+	static Group parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata)
 	{
-		return parseAlternative<0>(group, reportPart, reportMetadata);
+		return parseAlternative<0>(group,
+			reportPart,
+			reportMetadata,
+			dispatchTable().candidates(group, reportPart));
 	}
 
-	static Group reparse(const std::string & group,
+	// Same as parse() but only group types listed in Alternatives are tried
+	template <typename... Alternatives>
+	static Group parseOnly(std::string_view group,
+		ReportPart reportPart,
+		const ReportMetadata & reportMetadata)
+	{
+		const auto candidates = dispatchTable().candidates(group, reportPart) &
+			(alternativeBit<Alternatives>() | ...);
+		return parseAlternative<0>(group, reportPart, reportMetadata, candidates);
+	}
+
+	static Group reparse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata,
 		const Group & previous)
 	{
-		return reparseAlternative<0>(group, reportPart, reportMetadata, previous.index());
+		const auto candidates = dispatchTable().candidates(group, reportPart) &
+			~(AlternativeMask(1) << previous.index());
+		return parseAlternative<0>(group, reportPart, reportMetadata, candidates);
 	}
 private:
-	template <size_t I>
-	static Group parseAlternative(const std::string & group,
-		ReportPart reportPart,
-		const ReportMetadata & reportMetadata)
-	{
-		using Alternative = std::variant_alternative_t<I, Group>;
-		if constexpr (!std::is_same<Alternative, FallbackGroup>::value) {
-			const auto parsed = Alternative::parse(group, reportPart, reportMetadata);
-			if (parsed.has_value()) return *parsed;
+	// Bit I is set if variant alternative I is worth trying
+	using AlternativeMask = std::uint32_t;
+	static_assert(std::variant_size_v<Group> <= sizeof(AlternativeMask) * 8,
+		"Too many alternatives in Group for AlternativeMask");
+
+	// Alternatives which may recognise a group string, precomputed from
+	// group signatures per report part, per first char and per length
+	class DispatchTable {
+	public:
+		constexpr DispatchTable() {
+			addSignatures(std::make_index_sequence<std::variant_size_v<Group>>());
 		}
-		if constexpr (I >= (std::variant_size_v<Group> - 1)) {
-			return FallbackGroup();
+		constexpr AlternativeMask candidates(std::string_view group,
+			ReportPart reportPart) const
+		{
+			const auto rp = static_cast<std::size_t>(reportPart);
+			if (group.empty() || rp >= reportPartsNum) return allAlternatives;
+			const auto c = static_cast<unsigned char>(group[0]);
+			const auto len = (group.length() < maxLength) ?
+				group.length() : maxLength;
+			return (byFirstChar[rp][c] & byLength[rp][len]);
+		}
+	private:
+		// Lengths from maxLength and above share the same entry
+		static const inline std::size_t maxLength = 16;
+		static const inline std::size_t reportPartsNum =
+			static_cast<std::size_t>(ReportPart::RMK) + 1;
+		static const inline AlternativeMask allAlternatives = ~AlternativeMask(0);
+
+		AlternativeMask byFirstChar[reportPartsNum][256] = {};
+		AlternativeMask byLength[reportPartsNum][maxLength + 1] = {};
+
+		template <std::size_t... I>
+		constexpr void addSignatures(std::index_sequence<I...>) {
+			(addAlternative<I>(), ...);
+		}
+
+		template <std::size_t I>
+		constexpr void addAlternative() {
+			using Alternative = std::variant_alternative_t<I, Group>;
+			if constexpr (!std::is_same<Alternative, FallbackGroup>::value) {
+				for (const auto & s : Alternative::signatures)
+					addSignature(s, AlternativeMask(1) << I);
+			}
+		}
+
+		constexpr void addSignature(const GroupSignature & s, AlternativeMask bit) {
+			for (auto rp = 0u; rp < reportPartsNum; rp++) {
+				if (!(s.reportParts & (1u << rp))) continue;
+				if (s.firstCharClasses & GroupSignature::DIGITS)
+					for (auto c = '0'; c <= '9'; c++)
+						byFirstChar[rp][static_cast<unsigned char>(c)] |= bit;
+				if (s.firstCharClasses & GroupSignature::LETTERS)
+					for (auto c = 'A'; c <= 'Z'; c++)
+						byFirstChar[rp][static_cast<unsigned char>(c)] |= bit;
+				for (auto c = s.firstChars; *c; c++)
+					byFirstChar[rp][static_cast<unsigned char>(*c)] |= bit;
+				const auto maxLen = (s.maxLength < maxLength) ?
+					s.maxLength : maxLength;
+				for (auto len = s.minLength; len <= maxLen; len++)
+					byLength[rp][len] |= bit;
+			}
+		}
+	};
+	static const DispatchTable & dispatchTable() {
+		// Defined here since DispatchTable is complete only within function bodies
+		static constexpr DispatchTable table;
+		return table;
+	}
+
+	template <typename Alternative, size_t I = 0>
+	static constexpr AlternativeMask alternativeBit() {
+		if constexpr (std::is_same<std::variant_alternative_t<I, Group>, Alternative>::value) {
+			return AlternativeMask(1) << I;
 		} else {
-			return parseAlternative<I+1>(group, reportPart, reportMetadata);
+			return alternativeBit<Alternative, I+1>();
 		}
 	}
 
 	template <size_t I>
-	static Group reparseAlternative(const std::string & group,
+	static Group parseAlternative(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata,
-		size_t ignoreIndex)
+		AlternativeMask candidates)
 	{
 		using Alternative = std::variant_alternative_t<I, Group>;
 		if constexpr (!std::is_same<Alternative, FallbackGroup>::value) {
-			if (I != ignoreIndex) {
+			if (candidates & (AlternativeMask(1) << I)) {
 				const auto parsed = Alternative::parse(group, reportPart, reportMetadata);
 				if (parsed.has_value()) return *parsed;
 			}
@@ -2144,7 +2446,7 @@ private:
 		if constexpr (I >= (std::variant_size_v<Group> - 1)) {
 			return FallbackGroup();
 		} else {
-			return reparseAlternative<I+1>(group, reportPart, reportMetadata, ignoreIndex);
+			return parseAlternative<I+1>(group, reportPart, reportMetadata, candidates);
 		}
 	}
 };
@@ -2154,36 +2456,124 @@ struct ParseResult {
 	std::vector<GroupInfo> groups;
 };
 
+// Parse context is reused when parsing multiple reports in order to avoid
+// allocating memory for every report and every group. Clearing the context
+// keeps the capacity of result's group vector, and raw string buffers
+// which did not fit into std::string's own storage are kept for reuse by
+// subsequent groups.
+class ParseContext {
+public:
+	ParseResult result;
+	inline void clear();
+
+private:
+	friend class Parser;
+	inline std::string makeRawString(std::string_view s);
+	inline void appendRawString(std::string & rawString, std::string_view s);
+	inline void recycleRawString(std::string && s);
+
+	std::vector<std::string> spareRawStrings;
+	static const inline auto inplaceRawStringCapacity = std::string().capacity();
+};
+
+class LazyParseResult;
+
 class Parser {
 public:
-	static inline ParseResult parse (const std::string & report, size_t groupLimit = 200);
+	static inline ParseResult parse (std::string_view report, size_t groupLimit = 200);
+	// Parses report into context.result, reusing memory owned by context
+	static inline const ParseResult & parse(std::string_view report,
+		ParseContext & context,
+		size_t groupLimit = 200);
+	// Parses report given as its group strings with delimiters removed
+	// (e.g. as decoded by ReportCodec), so that the report does not need
+	// to be joined and split again; result is the same as if the group
+	// strings were joined with spaces and parsed as report
+	static inline const ParseResult & parseGroups(
+		const std::vector<std::string_view> & groups,
+		ParseContext & context,
+		size_t groupLimit = 200);
+	// Parses every report in range and passes the results to callback
+	// as callback(index, result). Reports may be any range of strings or
+	// string views. Result is only valid until callback returns.
+	template <typename Reports, typename Callback>
+	static void parseBatch(const Reports & reports,
+		ParseContext & context,
+		Callback && callback,
+		size_t groupLimit = 200)
+	{
+		std::size_t index = 0;
+		for (const auto & report : reports) {
+			callback(index++, parse(std::string_view(report), context, groupLimit));
+		}
+	}
+	// Parses only report header (and first group of report body to detect
+	// NIL and CNL reports, along with AUTO and COR groups before it); sets
+	// report type, location, report time, SPECI, AUTO, COR, AMD, NIL, CNL
+	// and TAF time span in the metadata. Other groups of report body and
+	// remarks are not parsed, thus metadata which comes from them is not
+	// set, and report error only reflects syntax errors in report header.
+	static inline ReportMetadata parseMetadata(std::string_view report);
+	// Prepares lazy parsing of report: groups are only parsed when they 
+	// are accessed via LazyParseResult. Report is not copied and must 
+	// remain valid while LazyParseResult is in use.
+	static inline LazyParseResult parseLazy(std::string_view report,
+		size_t groupLimit = 200);
+	// Same as above, reusing memory owned by lazyResult
+	static inline void parseLazy(std::string_view report,
+		LazyParseResult & lazyResult,
+		size_t groupLimit = 200);
 
 private:
-	static inline bool appendToLastResultGroup(ParseResult & result,
-		const std::string & groupStr,
+	friend class LazyParseResult;
+	class ParseState;
+	static inline bool parseNextGroup(ParseContext & context, ParseState & state);
+	static inline void finishParse(ParseContext & context, ParseState & state);
+	static inline bool appendToLastResultGroup(ParseContext & context,
+		std::string_view groupStr,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata,
 		bool allowReparse = true);
-	static inline void addGroupToResult(ParseResult & result,
+	static inline void addGroupToResult(ParseContext & context,
 		Group group,
 		ReportPart reportPart,
-		std::string groupString);
+		std::string_view groupString);
 	static inline void updateMetadata(const Group & group,
 		ReportMetadata & reportMetadata);
 
 
 	class ReportInput {
 	public:
-		ReportInput(const std::string & s) : report(s) {}
-		friend ReportInput & operator >> (ReportInput & input, std::string & output) {
+		ReportInput(std::string_view s) : report(s) {}
+		ReportInput(const std::string_view * groups, size_t count) :
+			nextGroups(groups), groupsLeft(count) {}
+		friend ReportInput & operator >> (ReportInput & input, std::string_view & output) {
 			output = input.getNextGroup();
 			return input;
 		}
 	private:
-		inline std::string getNextGroup();
-		const std::string & report;
+		inline std::string_view getNextGroup();
+		inline size_t scalarLimit(size_t from) const;
+		inline size_t findGroupEnd();
+		inline size_t findNext(size_t from, bool groupEnd);
+		inline void loadBlock(size_t position);
+		static inline unsigned int countTrailingZeros(std::uint64_t mask);
+		std::string_view report;
 		bool finished = false;
 		size_t pos = 0;
+		// Group strings which follow the report when parsing group strings
+		const std::string_view * nextGroups = nullptr;
+		size_t groupsLeft = 0;
+
+		// Report is scanned in blocks of 64 chars; for each char of the 
+		// current block there is a bit in each mask:
+		// notDelimiters: char is not a delimiter (i.e. above ' ')
+		// groupEnds: char is a delimiter, reportEndChar or '+'
+		static const inline size_t blockSize = 64;
+		static const inline size_t scalarLookahead = 16;
+		size_t blockPos = std::string_view::npos;
+		std::uint64_t notDelimiters = 0;
+		std::uint64_t groupEnds = 0;
 	};
 
 
@@ -2202,6 +2592,7 @@ private:
 		bool isReparseRequired() {
 			return (state == State::REPORT_BODY_BEGIN_METAR_REPEAT_PARSE);
 		}
+		inline bool isHeaderComplete();
 		void setError(ReportError e) { state = State::ERROR; reportError = e; }
 	private:
 		enum class State {
@@ -2238,6 +2629,41 @@ private:
 		ReportType reportType;
 		ReportError reportError;
 	};
+
+	// State of the report being parsed, kept between parseNextGroup() calls
+	class ParseState {
+	public:
+		explicit ParseState(std::string_view report = std::string_view(),
+			size_t limit = 200) : input(report), groupLimit(limit) {}
+		ParseState(ReportInput in, size_t limit) : input(in), groupLimit(limit) {}
+		ReportInput input;
+		Status status;
+		ReportMetadata reportMetadata;
+		size_t groupLimit;
+		size_t groupCount = 0;
+		bool finished = false;
+	};
+};
+
+// Result of Parser::parseLazy(); groups are parsed in the same order and 
+// in the same way as by Parser::parse() but only as far as required to 
+// provide the group being accessed. Metadata and groups are the same as 
+// in ParseResult returned by Parser::parse().
+class LazyParseResult {
+public:
+	// Returns group with given index or nullptr if there is no such group
+	// in the report; pointer is valid until this result is accessed again
+	inline const GroupInfo * group(size_t index);
+	// Parses all remaining groups
+	inline const ParseResult & result();
+	const ReportMetadata & reportMetadata() { return result().reportMetadata; }
+	const std::vector<GroupInfo> & groups() { return result().groups; }
+	bool isParsed() const { return state.finished; }
+
+private:
+	friend class Parser;
+	ParseContext context;
+	Parser::ParseState state;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2497,12 +2923,23 @@ inline void Visitor<void>::visit(const GroupInfo & groupInfo) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-inline std::optional<unsigned int> strToUint(const std::string & str,
+inline std::optional<unsigned int> strToUint(std::string_view str,
 	std::size_t startPos,
 	std::size_t digits);
 
 inline std::optional<std::pair<unsigned int, unsigned int> > fractionStrToUint(
-	const std::string & str,
+	std::string_view str,
+	std::size_t startPos,
+	std::size_t length);
+
+inline bool isDigit(char c) { return (c >= '0' && c <= '9'); }
+inline bool isUpperLetter(char c) { return (c >= 'A' && c <= 'Z'); }
+inline bool isDigitOrSlash(char c) { return (isDigit(c) || c == '/'); }
+inline bool isCharOf(char c, const char * chars) {
+	return (c && std::strchr(chars, c));
+}
+
+inline bool isSlashStr(std::string_view str,
 	std::size_t startPos,
 	std::size_t length);
 
@@ -2513,14 +2950,14 @@ inline std::optional<std::pair<unsigned int, unsigned int> > fractionStrToUint(
 
 namespace metaf {
 
-std::optional<unsigned int> strToUint(const std::string & str,
+std::optional<unsigned int> strToUint(std::string_view str,
 	std::size_t startPos,
 	std::size_t digits)
 {
 	std::optional<unsigned int> error;
 	if (str.empty() || !digits || startPos + digits > str.length()) return error;
 	unsigned int value = 0;
-	for (auto [i,c] = std::pair(0u, str.c_str() + startPos); i < digits; i++, c++) {
+	for (auto [i,c] = std::pair(0u, str.data() + startPos); i < digits; i++, c++) {
 		if (*c < '0' || *c > '9') return error;
 		static const auto decimalRadix = 10u;
 		value = value * decimalRadix + (*c - '0');
@@ -2528,8 +2965,18 @@ std::optional<unsigned int> strToUint(const std::string & str,
 	return value;
 }
 
+bool isSlashStr(std::string_view str,
+	std::size_t startPos,
+	std::size_t length)
+{
+	if (!length || startPos + length > str.length()) return false;
+	for (auto i = startPos; i < startPos + length; i++)
+		if (str[i] != '/') return false;
+	return true;
+}
+
 std::optional<std::pair<unsigned int, unsigned int> >
-	fractionStrToUint(const std::string & str,
+	fractionStrToUint(std::string_view str,
 		std::size_t startPos,
 		std::size_t length)
 {
@@ -2556,7 +3003,7 @@ std::optional<std::pair<unsigned int, unsigned int> >
 	return std::pair(*numerator, *denominator);
 }
 
-std::optional<Runway> Runway::fromString(const std::string & s, bool enableRwy) {
+std::optional<Runway> Runway::fromString(std::string_view s, bool enableRwy) {
 	//static const std::regex rgx("R(?:WY)?(\\d\\d)([RLC])?");
 	static const std::optional<Runway> error;
 	if (s.length() < 3) return error;
@@ -2619,47 +3066,37 @@ MetafTime::Date MetafTime::dateBeforeRef(const Date & refDate) const {
 	return result;
 }
 
-std::optional<MetafTime> MetafTime::fromStringDDHHMM(const std::string & s) {
+std::optional<MetafTime> MetafTime::fromStringDDHHMM(std::string_view s) {
 	//static const std::regex rgx ("(\\d\\d)?(\\d\\d)(\\d\\d)");
 	static const std::optional<MetafTime> error;
 	if (s.length() == 4) {
 		const auto hour = strToUint(s, 0, 2);
 		const auto minute = strToUint(s, 2, 2);
 		if (!hour.has_value() || !minute.has_value()) return error;
-		MetafTime metafTime;
-		metafTime.hourValue = *hour;
-		metafTime.minuteValue = *minute;
-		return metafTime;
+		return MetafTime(*hour, *minute);
 	}
 	if (s.length() == 6) {
 		const auto day = strToUint(s, 0, 2);
 		const auto hour = strToUint(s, 2, 2);
 		const auto minute = strToUint(s, 4, 2);
 		if (!day.has_value() || !hour.has_value() || !minute.has_value()) return error;
-		MetafTime metafTime;
-		metafTime.dayValue = day;
-		metafTime.hourValue = *hour;
-		metafTime.minuteValue = *minute;
-		return metafTime;
+		return MetafTime(day, *hour, *minute);
 	}
 	return error;
 }
 
-std::optional<MetafTime> MetafTime::fromStringDDHH(const std::string & s) {
+std::optional<MetafTime> MetafTime::fromStringDDHH(std::string_view s) {
 	//static const std::regex rgx ("(\\d\\d)(\\d\\d)");
 	static const std::optional<MetafTime> error;
 	if (s.length() != 4) return error;
 	const auto day = strToUint(s, 0, 2);
 	const auto hour = strToUint(s, 2, 2);
 	if (!day.has_value() || !hour.has_value()) return error;
-	MetafTime metafTime;
-	metafTime.dayValue = day;
-	metafTime.hourValue = *hour;
-	return metafTime;
+	return MetafTime(day, *hour, 0);
 }
 
 bool MetafTime::isValid() const {
-	if (auto d = dayValue.value_or(maxDay); d > maxDay || !d) return false;
+	if (auto d = day().value_or(maxDay); d > maxDay || !d) return false;
 	if (hourValue > maxHour) return false;
 	if (minuteValue > maxMinute) return false;
 	return true;
@@ -2746,7 +3183,7 @@ Temperature Temperature::windChill(
 	return Temperature(windChillC);
 }
 
-std::optional<Temperature> Temperature::fromString(const std::string & s) {
+std::optional<Temperature> Temperature::fromString(std::string_view s) {
 	//static const std::regex rgx ("(?:(M)?(\\d\\d))|//");
 	std::optional<Temperature> error;
 	if (s == "//") return Temperature();
@@ -2769,7 +3206,7 @@ std::optional<Temperature> Temperature::fromString(const std::string & s) {
 	return error;
 }
 
-std::optional<Temperature> Temperature::fromRemarkString(const std::string & s) {
+std::optional<Temperature> Temperature::fromRemarkString(std::string_view s) {
 	//static const std::regex ("([01])(\\d\\d\\d)");
 	std::optional<Temperature> error;
 	if (s.length() != 4) return error;
@@ -2793,7 +3230,7 @@ std::optional<float> Temperature::toUnit(Unit unit) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<Speed> Speed::fromString(const std::string & s, Unit unit) {
+std::optional<Speed> Speed::fromString(std::string_view s, Unit unit) {
 	//static const std::regex rgx ("([1-9]?\\d\\d)|//");
 	static const std::optional<Speed> error;
 	if (s.empty() || s == "//") return Speed();
@@ -2818,7 +3255,7 @@ std::optional<float> Speed::toUnit(Unit unit) const {
 	}
 }
 
-std::optional<Speed::Unit> Speed::unitFromString(const std::string & s) {
+std::optional<Speed::Unit> Speed::unitFromString(std::string_view s) {
 	if (s == "KT") return Speed::Unit::KNOTS;
 	if (s == "MPS") return Speed::Unit::METERS_PER_SECOND;
 	if (s == "KMH") return Speed::Unit::KILOMETERS_PER_HOUR;
@@ -2867,7 +3304,7 @@ std::optional<float> Speed::mphToUnit(float valueMph, Unit otherUnit) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-std::optional<Distance> Distance::fromMeterString(const std::string & s) {
+std::optional<Distance> Distance::fromMeterString(std::string_view s) {
 	//static const std::regex rgx ("(\\d\\d\\d\\d)|////");
 	static const std::optional<Distance> error;
 	if (s.length() != 4) return error;
@@ -2886,7 +3323,7 @@ std::optional<Distance> Distance::fromMeterString(const std::string & s) {
 	return distance;
 }
 
-std::optional<Distance> Distance::fromMileString(const std::string & s, 
+std::optional<Distance> Distance::fromMileString(std::string_view s, 
 	bool remarkFormat)
 {
 	// static const std::regex rgx ("([PM])?(\\d?\\d)(?:/(\\d?\\d))?SM|////SM");
@@ -2946,7 +3383,7 @@ std::optional<Distance> Distance::fromMileString(const std::string & s,
 	return distance;
 }
 
-std::optional<Distance> Distance::fromHeightString(const std::string & s) {
+std::optional<Distance> Distance::fromHeightString(std::string_view s) {
 	//static const std::regex rgx ("(\\d\\d\\d)|///");
 	static const std::optional<Distance> error;
 	if (s.length() != 3) return error;
@@ -2959,7 +3396,7 @@ std::optional<Distance> Distance::fromHeightString(const std::string & s) {
 	return distance;
 }
 
-std::optional<Distance> Distance::fromRvrString(const std::string & s, bool unitFeet) {
+std::optional<Distance> Distance::fromRvrString(std::string_view s, bool unitFeet) {
 	//static const std::regex rgx ("([PM])?(\\d\\d\\d\\d)|////");
 	static const std::optional<Distance> error;
 	Distance distance;
@@ -2984,7 +3421,7 @@ std::optional<Distance> Distance::fromRvrString(const std::string & s, bool unit
 }
 
 std::optional<std::pair<Distance, Distance>> Distance::fromLayerString(
-	const std::string & s)
+	std::string_view s)
 {
 	//static const std::regex rgx ("(\\d\\d\\d)(\\d)");
 	static const std::optional<std::pair<Distance, Distance>> error;
@@ -3001,7 +3438,7 @@ std::optional<std::pair<Distance, Distance>> Distance::fromLayerString(
 	return std::pair(baseHeight, topHeight);
 }
 
-std::optional<Distance> Distance::fromKmString(const std::string & s) {
+std::optional<Distance> Distance::fromKmString(std::string_view s) {
 	//static const std::regex rgx ("(\\d\\d?)KM");
 	static const std::optional<Distance> error;
 	static const auto metersPerKm = 1000u;
@@ -3181,7 +3618,7 @@ Distance Distance::makeVicinity() {
 ////////////////////////////////////////////////////////////////////////////////
 
 std::optional<Direction> Direction::fromCardinalString(
-	const std::string & s, 
+	std::string_view s, 
 	bool enableOhdAlqds,
 	bool enableUnknown)
 {
@@ -3223,7 +3660,7 @@ std::optional<Direction> Direction::fromCardinalString(
 	return dir;
 }
 
-std::optional<Direction> Direction::fromDegreesString(const std::string & s) {
+std::optional<Direction> Direction::fromDegreesString(std::string_view s) {
 	std::optional<Direction> error;
 	Direction direction;
 	if (s.length() != 3) return error;
@@ -3275,17 +3712,37 @@ Direction::Cardinal Direction::cardinal(bool trueDirections) const {
 }
 
 std::optional<std::pair<Direction, Direction>> Direction::fromSectorString(
-	const std::string & s)
+	std::string_view s)
 {
+	//static const std::regex rgx
+	//	("([NSWE][WE]?)(?:-[NSWE]|-[NS][WE])*-([NSWE][WE]?)");
 	static const std::optional<std::pair<Direction, Direction>> notRecognised;
-	static const std::regex rgx 
-		("([NSWE][WE]?)(?:-[NSWE]|-[NS][WE])*-([NSWE][WE]?)");
-	static const auto matchBegin = 1, matchEnd = 2;
-	std::smatch match;
-	if (!regex_match(s, match, rgx)) return notRecognised;
-	const auto dirBegin = fromCardinalString(match.str(matchBegin));
+	static const char delimiter = '-';
+	const auto firstDelimiterPos = s.find(delimiter);
+	if (firstDelimiterPos == std::string::npos) return notRecognised;
+	const auto lastDelimiterPos = s.rfind(delimiter);
+	// Each sector point between delimiters is 1 or 2 chars long
+	auto pointBegin = 0u;
+	while (pointBegin <= s.length()) {
+		auto pointEnd = s.find(delimiter, pointBegin);
+		if (pointEnd == std::string::npos) pointEnd = s.length();
+		const auto pointLength = pointEnd - pointBegin;
+		if (pointLength < 1 || pointLength > 2) return notRecognised;
+		const char c1 = s[pointBegin];
+		if (c1 != 'N' && c1 != 'S' && c1 != 'W' && c1 != 'E') return notRecognised;
+		if (pointLength == 2) {
+			const char c2 = s[pointBegin + 1];
+			if (c2 != 'W' && c2 != 'E') return notRecognised;
+			// Intermediate points are only allowed as N, S, W, E, NW, NE, SW, SE
+			const bool isEdgePoint =
+				(!pointBegin || pointBegin == lastDelimiterPos + 1);
+			if (!isEdgePoint && c1 != 'N' && c1 != 'S') return notRecognised;
+		}
+		pointBegin = pointEnd + 1;
+	}
+	const auto dirBegin = fromCardinalString(s.substr(0, firstDelimiterPos));
 	if (!dirBegin.has_value()) return(notRecognised);
-	const auto dirEnd = fromCardinalString(match.str(matchEnd));
+	const auto dirEnd = fromCardinalString(s.substr(lastDelimiterPos + 1));
 	if (!dirEnd.has_value()) return(notRecognised);
 	return std::pair(*dirBegin, *dirEnd);
 }
@@ -3370,7 +3827,7 @@ Direction::Direction(Cardinal c) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<Pressure> Pressure::fromString(const std::string & s) {
+std::optional<Pressure> Pressure::fromString(std::string_view s) {
 	//static const std::regex rgx("([QA])(?:(\\d\\d\\d\\d)|////)");
 	static const std::optional<Pressure> error;
 	if (s.length() != 5) return error;
@@ -3399,7 +3856,7 @@ std::optional<Pressure> Pressure::fromString(const std::string & s) {
 	return pressure;
 }
 
-std::optional<Pressure> Pressure::fromForecastString(const std::string & s) {
+std::optional<Pressure> Pressure::fromForecastString(std::string_view s) {
 	//static const std::regex rgx("QNH(\\d\\d\\d\\d)INS");
 	static const std::optional<Pressure> error;
 	if (s.length() != 10) return error;
@@ -3413,7 +3870,7 @@ std::optional<Pressure> Pressure::fromForecastString(const std::string & s) {
 	return pressure;
 }
 
-std::optional<Pressure> Pressure::fromSlpString(const std::string & s) {
+std::optional<Pressure> Pressure::fromSlpString(std::string_view s) {
 	//SLP982 = 998.2 hPa, SLP015 = 1001.5 hPa, SLP221 = 1022.1 hPa
 	//static const std::regex rgx("SLP(\\d\\d\\d)");
 	static const std::optional<Pressure> error;
@@ -3429,7 +3886,7 @@ std::optional<Pressure> Pressure::fromSlpString(const std::string & s) {
 	return pressure;
 }
 
-std::optional<Pressure> Pressure::fromQfeString(const std::string & s) {
+std::optional<Pressure> Pressure::fromQfeString(std::string_view s) {
 	//static const std::regex rgx("QFE(\\d\\d\\d)(/\\d\\d\\d\\d)?");
 	static const std::optional<Pressure> error;
 	if (s.length() != 6 && s.length() != 11) return error;
@@ -3447,7 +3904,7 @@ std::optional<Pressure> Pressure::fromQfeString(const std::string & s) {
 	return pressure;
 }
 
-std::optional<Pressure> Pressure::fromTendencyString(const std::string & s) {
+std::optional<Pressure> Pressure::fromTendencyString(std::string_view s) {
 	//static const std::regex rgx("(\\d\\d\\d)|///");
 	static const std::optional<Pressure> error;
 	if (s.length() != 3) return error;
@@ -3492,7 +3949,7 @@ std::optional<float> Pressure::toUnit(Unit unit) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<Precipitation> Precipitation::fromRainfallString(const std::string & s) {
+std::optional<Precipitation> Precipitation::fromRainfallString(std::string_view s) {
 	//static const std::regex rgx("\\d?\\d\\d\\.\\d");
 	static const std::optional<Precipitation> error;
 	if (s == "///./" || s == "//./") return Precipitation();
@@ -3507,7 +3964,7 @@ std::optional<Precipitation> Precipitation::fromRainfallString(const std::string
 	return precipitation;
 }
 
-std::optional<Precipitation> Precipitation::fromRunwayDeposits(const std::string & s) {
+std::optional<Precipitation> Precipitation::fromRunwayDeposits(std::string_view s) {
 	//static const std::regex rgx("\\d\\d");
 	std::optional<Precipitation> error;
 	if (s.length() != 2) return error;
@@ -3538,7 +3995,7 @@ std::optional<Precipitation> Precipitation::fromRunwayDeposits(const std::string
 	return precipitation;
 }
 
-std::optional<Precipitation> Precipitation::fromRemarkString(const std::string & s,
+std::optional<Precipitation> Precipitation::fromRemarkString(std::string_view s,
 		float factor,
 		Precipitation::Unit unit,
 		bool allowNotReported)
@@ -3559,7 +4016,7 @@ std::optional<Precipitation> Precipitation::fromRemarkString(const std::string &
 }
 
 std::optional<std::pair<Precipitation, Precipitation>>
-	Precipitation::fromSnincrString(const std::string & s)
+	Precipitation::fromSnincrString(std::string_view s)
 {
 	//static const std::regex rgx("\\d?\\d)/(\\d?\\d");
 	static const std::optional<std::pair<Precipitation, Precipitation>> error;
@@ -3593,7 +4050,7 @@ std::optional<float> Precipitation::toUnit(Unit unit) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<SurfaceFriction> SurfaceFriction::fromString(const std::string & s) {
+std::optional<SurfaceFriction> SurfaceFriction::fromString(std::string_view s) {
 	//static const std::regex rgx("\\d\\d");
 	static const std::optional<SurfaceFriction> error;
 	if (s.length() != 2) return error;
@@ -3658,7 +4115,7 @@ SurfaceFriction::BrakingAction SurfaceFriction::brakingAction() const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<WaveHeight> WaveHeight::fromString(const std::string & s) {
+std::optional<WaveHeight> WaveHeight::fromString(std::string_view s) {
 	//static const std::regex rgx("S(\\d)|H(\\d?\\d?\\d)");
 	static const std::optional<WaveHeight> error;
 	if (s.length() < 2 || s.length() > 4) return error;
@@ -3745,30 +4202,24 @@ WeatherPhenomena::Descriptor WeatherPhenomena::descriptor() const
 std::vector<WeatherPhenomena::Weather> WeatherPhenomena::weather() const 
 {
 	std::vector<Weather> result;
-	const uint32_t sz = (data >> weatherCountShiftBits) & weatherCountMask;
-	if (sz > 0) {
-		const Weather w = 
-			static_cast<Weather>((data >> weather0ShiftBits) & weatherMask);
-		result.push_back(w);
-	}
-	if (sz > 1) {
-		const Weather w = 
-			static_cast<Weather>((data >> weather1ShiftBits) & weatherMask);
-		result.push_back(w);
-	}
-	if (sz > 2) {
-		const Weather w = 
-			static_cast<Weather>((data >> weather2ShiftBits) & weatherMask);
-		result.push_back(w);
-	}
+	const auto sz = weatherCount();
+	result.reserve(sz);
+	for (auto i = 0u; i < sz; i++)
+		result.push_back(weatherAt(i));
 	return result;
 }
 
+WeatherPhenomena::Weather WeatherPhenomena::weatherAt(size_t index) const {
+	static const uint32_t shiftBits[wSize] = 
+		{weather0ShiftBits, weather1ShiftBits, weather2ShiftBits};
+	return static_cast<Weather>((data >> shiftBits[index]) & weatherMask);
+}
+
 WeatherPhenomena::Event WeatherPhenomena::event() const {
 	return static_cast<Event>((data >> eventShiftBits) & eventMask);
 }
 
-std::optional <WeatherPhenomena> WeatherPhenomena::fromString(const std::string & s,
+std::optional <WeatherPhenomena> WeatherPhenomena::fromString(std::string_view s,
 		bool enableQualifiers)
 {
 	// Descriptors MI, PR, BC are allowed only with FG
@@ -3851,8 +4302,10 @@ std::optional <WeatherPhenomena> WeatherPhenomena::fromString(const std::string
 	// Precipitation
 	Qualifier resultQualifier = Qualifier::NONE;
 	Descriptor resultDescriptor = Descriptor::NONE;
-	std::vector<Weather> resultWeather;
-	std::string precipStr = s;
+	Weather resultWeather[wSize] = 
+		{Weather::NOT_REPORTED, Weather::NOT_REPORTED, Weather::NOT_REPORTED};
+	size_t resultWeatherSize = 0;
+	std::string_view precipStr = s;
 	static const std::optional <WeatherPhenomena> error;
 	if (precipStr.length() < 2) return(error);
 	// Only + - RE qualifiers are allowed; no qualifier equals moderate intensity
@@ -3911,16 +4364,21 @@ std::optional <WeatherPhenomena> WeatherPhenomena::fromString(const std::string
 		if (!w.has_value()) return error;
 		if (isDescriptorShAllowed(*w)) allowShDecriptor = true;
 		if (isDescriptorFzAllowed(*w)) allowFzDecriptor = true;
-		for (auto j = 0u; j < resultWeather.size(); j++)
+		for (auto j = 0u; j < resultWeatherSize; j++)
 			if (resultWeather[j] == *w) return error;
-		resultWeather.push_back(*w);
+		resultWeather[resultWeatherSize++] = *w;
 		precipStr = precipStr.substr(2);
 	}
 	if (!precipStr.empty()) return error;
 	if (!allowShDecriptor && resultDescriptor == Descriptor::SHOWERS) return error;
 	if (!allowFzDecriptor && resultDescriptor == Descriptor::FREEZING) return error;
 	WeatherPhenomena result;
-	result.data = pack(resultQualifier, resultDescriptor, resultWeather);
+	result.data = pack(resultQualifier, 
+		resultDescriptor, 
+		resultWeatherSize,
+		resultWeather[0],
+		resultWeather[1],
+		resultWeather[2]);
 	return result;
 }
 
@@ -3971,35 +4429,32 @@ inline uint32_t WeatherPhenomena::pack(Qualifier q,
 	return result;
 }
 
-inline uint32_t WeatherPhenomena::pack(Qualifier q, 
-	Descriptor d,
-	std::vector<Weather> w,
-	Event e)
-{
-	const size_t sz = (w.size() <= 3 ? w.size() : 3);
-	const Weather w1 = (sz >= 1 ? w[0] : Weather::NOT_REPORTED);
-	const Weather w2 = (sz >= 2 ? w[1] : Weather::NOT_REPORTED);
-	const Weather w3 = (sz == 3 ? w[2] : Weather::NOT_REPORTED);
-	return pack(q, d, w.size(), w1, w2, w3, e);
-}
-
 std::optional <WeatherPhenomena> WeatherPhenomena::fromWeatherBeginEndString(
-	const std::string & s,
+	std::string_view s,
 	const MetafTime & reportTime,
 	const WeatherPhenomena & previous)
 {
+	//static const std::regex rgx("((?:[A-Z][A-Z]){0,4})([BE])(\\d\\d)?(\\d\\d)");
 	std::optional <WeatherPhenomena> error;
-	static const std::regex rgx("((?:[A-Z][A-Z]){0,4})([BE])(\\d\\d)?(\\d\\d)");
-	static const auto matchPhenomena = 1, matchEvent = 2;
-	static const auto matchHour = 3, matchMinute = 4;
-
-	std::smatch match;
-	if (!regex_match(s, match, rgx)) return error;
+	static const auto maxPhenomenaLength = 8u;
+
+	// Phenomena (even number of letters) and event letter B or E followed
+	// by the time in format HHMM or MM
+	auto eventPos = 0u;
+	while (eventPos < s.length() && isUpperLetter(s[eventPos])) eventPos++;
+	if (!eventPos || !(eventPos % 2)) return error;
+	eventPos--;
+	if (eventPos > maxPhenomenaLength) return error;
+	const auto timePos = eventPos + 1;
+	const auto timeLength = s.length() - timePos;
+	if (timeLength != 2 && timeLength != 4) return error;
+	const auto time = strToUint(s, timePos, timeLength);
+	if (!time.has_value()) return error;
 
 	WeatherPhenomena result;
 
-	if (const auto phstr = match.str(matchPhenomena); !phstr.empty()) {
-		const auto ph = fromString(phstr);
+	if (eventPos) {
+		const auto ph = fromString(s.substr(0, eventPos));
 		if (!ph.has_value()) return error;
 		result = *ph;
 	} else {
@@ -4009,27 +4464,28 @@ std::optional <WeatherPhenomena> WeatherPhenomena::fromWeatherBeginEndString(
 
 	Event resultEvent;
 
-	if (match.str(matchEvent) == "B") resultEvent = Event::BEGINNING;
-	if (match.str(matchEvent) == "E") resultEvent = Event::ENDING;
+	switch (s[eventPos]) {
+		case 'B': resultEvent = Event::BEGINNING; break;
+		case 'E': resultEvent = Event::ENDING; break;
+		default: return error;
+	}
 
-	result.data = pack(result.qualifier(), 
-		result.descriptor(), 
-		result.weather(), 
-		resultEvent);
+	result.data &= ~(eventMask << eventShiftBits);
+	result.data |= (static_cast<uint32_t>(resultEvent) << eventShiftBits);
 
+	static const auto decimalRadixSquared = 100u;
 	unsigned int hour = reportTime.hour();
-	unsigned int minute = static_cast<unsigned int>(std::stoi(match.str(matchMinute)));
-	if (const auto h = match.str(matchHour); !h.empty())
-		hour = static_cast<unsigned int>(std::stoi(h));
+	unsigned int minute = *time % decimalRadixSquared;
+	if (timeLength == 4) hour = *time / decimalRadixSquared;
 	result.tm = MetafTime(hour, minute);
 
 	return result;
 }
 
 bool WeatherPhenomena::isValid() const { 
-	const auto w = weather();
+	const auto wNum = weatherCount();
 	// Empty weather phenomena is not valid 
-	if (qualifier() == Qualifier::NONE && descriptor() == Descriptor::NONE && !w.size()) 
+	if (qualifier() == Qualifier::NONE && descriptor() == Descriptor::NONE && !wNum) 
 		return false;
 	// Event time must be valid if present
 	if (tm.has_value() && !tm->isValid()) return false;
@@ -4037,9 +4493,10 @@ bool WeatherPhenomena::isValid() const {
 	// can potentially freeze, i.e. DZ RA, or with UP, or with FG
 	if (descriptor() == Descriptor::FREEZING) {
 		bool dzRaUpFg = false;
-		for (auto i = 0u; i < wSize; i++) {
-			if (w[i] == Weather::DRIZZLE || w[i] == Weather::RAIN ||
-				w[i] == Weather::UNDETERMINED || w[i] == Weather::FOG) 
+		for (auto i = 0u; i < wNum; i++) {
+			const auto w = weatherAt(i);
+			if (w == Weather::DRIZZLE || w == Weather::RAIN ||
+				w == Weather::UNDETERMINED || w == Weather::FOG) 
 			{
 				dzRaUpFg = true; break;
 			}
@@ -4052,7 +4509,7 @@ bool WeatherPhenomena::isValid() const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<CloudType> CloudType::fromString(const std::string & s) {
+std::optional<CloudType> CloudType::fromString(std::string_view s) {
 	static const std::optional<CloudType> error;
 	if (s.empty()) return error;
 	if (s[0] >= '0' && s[0] <= '9') {
@@ -4081,7 +4538,7 @@ std::optional<CloudType> CloudType::fromString(const std::string & s) {
 	}
 }
 
-std::optional<CloudType> CloudType::fromStringObscuration(const std::string & s) {
+std::optional<CloudType> CloudType::fromStringObscuration(std::string_view s) {
 	auto type = Type::NOT_REPORTED;
 	if (s == "BLSN") type = Type::BLOWING_SNOW;
 	if (s == "BLDU") type = Type::BLOWING_DUST;
@@ -4094,7 +4551,7 @@ std::optional<CloudType> CloudType::fromStringObscuration(const std::string & s)
 }
 
 
-CloudType::Type CloudType::cloudTypeFromString(const std::string & s) {
+CloudType::Type CloudType::cloudTypeFromString(std::string_view s) {
 	if (s == "CB")    return Type::CUMULONIMBUS;
 	if (s == "TCU")   return Type::TOWERING_CUMULUS;
 	if (s == "CU")    return Type::CUMULUS;
@@ -4112,7 +4569,7 @@ CloudType::Type CloudType::cloudTypeFromString(const std::string & s) {
 	return Type::NOT_REPORTED;
 }
 
-CloudType::Type CloudType::cloudTypeOrObscurationFromString(const std::string & s) {
+CloudType::Type CloudType::cloudTypeOrObscurationFromString(std::string_view s) {
 	if (const auto t = cloudTypeFromString(s); t != Type::NOT_REPORTED) return t;
 	if (s == "BLSN")  return Type::BLOWING_SNOW;
 	if (s == "BLDU")  return Type::BLOWING_DUST;
@@ -4132,7 +4589,7 @@ CloudType::Type CloudType::cloudTypeOrObscurationFromString(const std::string &
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<KeywordGroup> KeywordGroup::parse(const std::string & group,
+std::optional<KeywordGroup> KeywordGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4170,7 +4627,7 @@ std::optional<KeywordGroup> KeywordGroup::parse(const std::string & group,
 	return std::optional<KeywordGroup>();
 }
 
-AppendResult KeywordGroup::append(const std::string & group,
+AppendResult KeywordGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4180,22 +4637,25 @@ AppendResult KeywordGroup::append(const std::string & group,
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<LocationGroup> LocationGroup::parse(const std::string & group,
+std::optional<LocationGroup> LocationGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	static const std::optional<LocationGroup> notRecognised;
 	if (reportPart != ReportPart::HEADER) return notRecognised;
-	static const std::regex rgx = std::regex("[A-Z][A-Z0-9]{3}");
-	if (!regex_match(group, rgx)) return notRecognised;
+	//static const std::regex rgx = std::regex("[A-Z][A-Z0-9]{3}");
+	if (group.length() != locationLength) return notRecognised;
+	if (!isUpperLetter(group[0])) return notRecognised;
+	for (auto i = 1u; i < locationLength; i++)
+		if (!isUpperLetter(group[i]) && !isDigit(group[i])) return notRecognised;
 	LocationGroup result;
-	strncpy(result.location, group.c_str(), locationLength);
+	strncpy(result.location, group.data(), locationLength);
 	result.location[locationLength] = '\0';
 	return result;
 }
 
-AppendResult LocationGroup::append(const std::string & group,
+AppendResult LocationGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4205,16 +4665,17 @@ AppendResult LocationGroup::append(const std::string & group,
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<ReportTimeGroup> ReportTimeGroup::parse(const std::string & group,
+std::optional<ReportTimeGroup> ReportTimeGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	static const std::optional<ReportTimeGroup> notRecognised;
-	static const std::regex rgx ("\\d\\d\\d\\d\\d\\dZ");
+	//static const std::regex rgx ("\\d\\d\\d\\d\\d\\dZ");
 	static const auto posTime = 0, lenTime = 6;
 	if (reportPart != ReportPart::HEADER) return notRecognised;
-	if (!regex_match(group, rgx)) return notRecognised;
+	if (group.length() != lenTime + 1 || group[lenTime] != 'Z') return notRecognised;
+	if (!strToUint(group, posTime, lenTime).has_value()) return notRecognised;
 	const auto tm = MetafTime::fromStringDDHHMM(group.substr(posTime, lenTime));
 	if (!tm.has_value()) return notRecognised;
 	if (!tm->day().has_value()) return notRecognised;
@@ -4223,7 +4684,7 @@ std::optional<ReportTimeGroup> ReportTimeGroup::parse(const std::string & group,
 	return g;
 }
 
-AppendResult ReportTimeGroup::append(const std::string & group,
+AppendResult ReportTimeGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4233,7 +4694,7 @@ AppendResult ReportTimeGroup::append(const std::string & group,
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<TrendGroup> TrendGroup::parse(const std::string & group,
+std::optional<TrendGroup> TrendGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4269,7 +4730,7 @@ std::optional<TrendGroup> TrendGroup::parse(const std::string & group,
 	return std::optional<TrendGroup>();
 }
 
-AppendResult TrendGroup::append(const std::string & group,
+AppendResult TrendGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4284,14 +4745,13 @@ AppendResult TrendGroup::append(const std::string & group,
 	return AppendResult::NOT_APPENDED;
 }
 
-std::optional<TrendGroup> TrendGroup::fromTimeSpan(const std::string & s) {
+std::optional<TrendGroup> TrendGroup::fromTimeSpan(std::string_view s) {
+	//static const std::regex rgx("(\\d\\d\\d\\d)/(\\d\\d\\d\\d)");
 	static const std::optional<TrendGroup> notRecognised;
-	static const std::regex rgx("(\\d\\d\\d\\d)/(\\d\\d\\d\\d)");
-	static const auto matchFrom = 1, matchTill = 2;
-	std::smatch match;
-	if (!regex_match(s, match, rgx)) return notRecognised;
-	const auto from = MetafTime::fromStringDDHH(match.str(matchFrom));
-	const auto till = MetafTime::fromStringDDHH(match.str(matchTill));
+	static const auto posFrom = 0, posTill = 5, lenTime = 4;
+	if (s.length() != posTill + lenTime || s[lenTime] != '/') return notRecognised;
+	const auto from = MetafTime::fromStringDDHH(s.substr(posFrom, lenTime));
+	const auto till = MetafTime::fromStringDDHH(s.substr(posTill, lenTime));
 	if (!from.has_value() || !till.has_value()) return notRecognised;
 
 	TrendGroup result;
@@ -4302,14 +4762,13 @@ std::optional<TrendGroup> TrendGroup::fromTimeSpan(const std::string & s) {
 	return result;
 }
 
-std::optional<TrendGroup> TrendGroup::fromTimeSpanHHMM(const std::string & s) {
+std::optional<TrendGroup> TrendGroup::fromTimeSpanHHMM(std::string_view s) {
+	//static const std::regex rgx("(\\d\\d\\d\\d)/(\\d\\d\\d\\d)");
 	static const std::optional<TrendGroup> notRecognised;
-	static const std::regex rgx("(\\d\\d\\d\\d)/(\\d\\d\\d\\d)");
-	static const auto matchFrom = 1, matchTill = 2;
-	std::smatch match;
-	if (!regex_match(s, match, rgx)) return notRecognised;
-	const auto from = MetafTime::fromStringDDHHMM(match.str(matchFrom));
-	const auto till = MetafTime::fromStringDDHHMM(match.str(matchTill));
+	static const auto posFrom = 0, posTill = 5, lenTime = 4;
+	if (s.length() != posTill + lenTime || s[lenTime] != '/') return notRecognised;
+	const auto from = MetafTime::fromStringDDHHMM(s.substr(posFrom, lenTime));
+	const auto till = MetafTime::fromStringDDHHMM(s.substr(posTill, lenTime));
 	if (!from.has_value() || !till.has_value()) return notRecognised;
 
 	TrendGroup result;
@@ -4320,11 +4779,12 @@ std::optional<TrendGroup> TrendGroup::fromTimeSpanHHMM(const std::string & s) {
 	return result;
 }
 
-std::optional<TrendGroup> TrendGroup::fromFm(const std::string & s) {
+std::optional<TrendGroup> TrendGroup::fromFm(std::string_view s) {
 	static const std::optional<TrendGroup> notRecognised;
-	static const std::regex rgx("FM\\d\\d\\d\\d\\d\\d");
+	//static const std::regex rgx("FM\\d\\d\\d\\d\\d\\d");
 	static const auto posTime = 2, lenTime = 6;
-	if (!regex_match(s, rgx)) return notRecognised;
+	if (s.length() != posTime + lenTime || s[0] != 'F' || s[1] != 'M')
+		return notRecognised;
 	const auto time = MetafTime::fromStringDDHHMM(s.substr(posTime, lenTime));
 	if (!time.has_value()) return notRecognised;
 
@@ -4334,26 +4794,26 @@ std::optional<TrendGroup> TrendGroup::fromFm(const std::string & s) {
 	return result;
 }
 
-std::optional<TrendGroup> TrendGroup::fromTrendTime(const std::string & s) {
+std::optional<TrendGroup> TrendGroup::fromTrendTime(std::string_view s) {
 	static const std::optional<TrendGroup> notRecognised;
-	static const std::regex rgx("([FTA][MLT])(\\d\\d\\d\\d)");
-	static const auto matchType = 1, matchTime = 2;
-	std::smatch match;
-	if (!regex_match(s, match, rgx)) return notRecognised;
-	const auto time = MetafTime::fromStringDDHHMM(match.str(matchTime));
+	//static const std::regex rgx("([FTA][MLT])(\\d\\d\\d\\d)");
+	static const auto posTime = 2, lenTime = 4;
+	if (s.length() != posTime + lenTime) return notRecognised;
+	const auto time = MetafTime::fromStringDDHHMM(s.substr(posTime, lenTime));
 	if (!time.has_value()) return notRecognised;
+	const auto typeStr = s.substr(0, posTime);
 	TrendGroup result;
-	if (match.str(matchType) == "FM") {
+	if (typeStr == "FM") {
 		result.t = Type::FROM;
 		result.tFrom = time;
 		return result;
 	}
-	if (match.str(matchType) == "TL") {
+	if (typeStr == "TL") {
 		result.t = Type::UNTIL;
 		result.tTill = time;
 		return result;
 	}
-	if (match.str(matchType) == "AT") {
+	if (typeStr == "AT") {
 		result.t = Type::AT;
 		result.tAt = time;
 		return result;
@@ -4468,7 +4928,7 @@ void TrendGroup::combineTime(const TrendGroup & nextTrendGroup) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<WindGroup> WindGroup::parse(const std::string & group,
+std::optional<WindGroup> WindGroup::parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata)
 {
@@ -4493,50 +4953,81 @@ std::optional<WindGroup> WindGroup::parse(const std::string & group,
 	if (const auto result = parseVariableSector(group); result.has_value())
 		return *result;
 
-	static const std::regex windRgx("(?:WS(\\d\\d\\d)/)?"
-		"(\\d\\d0|VRB|///)([1-9]?\\d\\d|//)(?:G([1-9]?\\d\\d))?([KM][TMP][HS]?)");
-	static const auto matchWindShearHeight = 1, matchWindDir = 2;
-	static const auto matchWindSpeed = 3, matchWindGust = 4, matchWindUnit = 5;
+	//static const std::regex windRgx("(?:WS(\\d\\d\\d)/)?"
+	//	"(\\d\\d0|VRB|///)([1-9]?\\d\\d|//)(?:G([1-9]?\\d\\d))?([KM][TMP][HS]?)");
+	static const auto lenWsHeight = 3, lenDir = 3;
 
 	// Surface wind or wind shear, e.g. dd0ssKT or dd0ssGggMPS or WShhhdd0ssGggKT
-	if (std::smatch match; std::regex_match(group, match, windRgx)) {
-		const auto speedUnit = Speed::unitFromString(match.str(matchWindUnit));
-		if (!speedUnit.has_value()) return notRecognised;
-		const auto speed = Speed::fromString(match.str(matchWindSpeed), *speedUnit);
-		if (!speed.has_value()) return notRecognised;
-
-		WindGroup result;
-
-		if (!match.length(matchWindShearHeight) && 
-			!match.length(matchWindGust) &&
-			match.str(matchWindDir) == "000" &&
-			match.str(matchWindSpeed) == "00")
-		{
-			//00000KT or 00000MPS or 00000KMH: calm wind
-			result.windType = Type::SURFACE_WIND_CALM;
-			result.wSpeed = *speed;
-			return result;
-		}
+	std::string_view wsHeightStr;
+	std::size_t pos = 0;
+	if (group.length() > 6 && group[0] == 'W' && group[1] == 'S' &&
+		group[5] == '/' && strToUint(group, 2, lenWsHeight).has_value())
+	{
+		wsHeightStr = group.substr(2, lenWsHeight);
+		pos = 6;
+	}
+
+	if (group.length() < pos + lenDir) return notRecognised;
+	const auto dirStr = group.substr(pos, lenDir);
+	if (dirStr != "VRB" && dirStr != "///" &&
+		(dirStr[2] != '0' || !strToUint(dirStr, 0, 2).has_value()))
+			return notRecognised;
+	pos += lenDir;
+
+	// Only KT, MPS and KMH units are recognised, thus the unit is 
+	// either the last 2 or the last 3 chars of the group
+	std::optional<Speed::Unit> speedUnit;
+	auto unitPos = group.length();
+	for (auto unitLen : {3u, 2u}) {
+		if (speedUnit.has_value() || group.length() < pos + unitLen) continue;
+		speedUnit = Speed::unitFromString(group.substr(group.length() - unitLen));
+		if (speedUnit.has_value()) unitPos = group.length() - unitLen;
+	}
+	if (!speedUnit.has_value()) return notRecognised;
+
+	const auto gustPos = group.find('G', pos);
+	const auto speedEnd = (gustPos < unitPos) ? gustPos : unitPos;
+	const auto speedStr = group.substr(pos, speedEnd - pos);
+	std::string_view gustStr;
+	if (gustPos < unitPos) {
+		gustStr = group.substr(gustPos + 1, unitPos - gustPos - 1);
+		if (gustStr.empty() || gustStr == "//") return notRecognised;
+	}
+	if (speedStr.empty()) return notRecognised;
+
+	const auto speed = Speed::fromString(speedStr, *speedUnit);
+	if (!speed.has_value()) return notRecognised;
+	const auto gust = Speed::fromString(gustStr, *speedUnit);
+	if (!gust.has_value()) return notRecognised;
 
-		const auto dir = Direction::fromDegreesString(match.str(matchWindDir));
-		if (!dir.has_value()) return notRecognised;
-		result.windDir = *dir;
+	WindGroup result;
+
+	if (wsHeightStr.empty() && 
+		gustStr.empty() &&
+		dirStr == "000" &&
+		speedStr == "00")
+	{
+		//00000KT or 00000MPS or 00000KMH: calm wind
+		result.windType = Type::SURFACE_WIND_CALM;
 		result.wSpeed = *speed;
-		const auto gust = Speed::fromString(match.str(matchWindGust), *speedUnit);
-		if (gust.has_value()) result.gSpeed = *gust;
-		const auto wsHeight = Distance::fromHeightString(match.str(matchWindShearHeight));
-		result.windType = Type::SURFACE_WIND;
-		if (wsHeight.has_value()) {
-			result.windType = Type::WIND_SHEAR;
-			result.wShHeight = *wsHeight;
-		}
 		return result;
 	}
 
-	return notRecognised;
+	const auto dir = Direction::fromDegreesString(dirStr);
+	if (!dir.has_value()) return notRecognised;
+	result.windDir = *dir;
+	result.wSpeed = *speed;
+	result.gSpeed = *gust;
+	const auto wsHeight = Distance::fromHeightString(wsHeightStr);
+	result.windType = Type::SURFACE_WIND;
+	if (wsHeight.has_value()) {
+		result.windType = Type::WIND_SHEAR;
+		result.wShHeight = *wsHeight;
+	}
+	return result;
 }
 
-AppendResult WindGroup::append(const std::string & group,
+AppendResult WindGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4583,25 +5074,27 @@ AppendResult WindGroup::append(const std::string & group,
 	}
 }
 
-std::optional<WindGroup> WindGroup::parseVariableSector(const std::string & group) {
+std::optional<WindGroup> WindGroup::parseVariableSector(std::string_view group) {
 	static const std::optional<WindGroup> notRecognised;
-	static const std::regex varWindRgx("(\\d\\d0)V(\\d\\d0)");
-	static const auto matchVarWindBegin = 1, matchVarWindEnd = 2;
+	//static const std::regex varWindRgx("(\\d\\d0)V(\\d\\d0)");
+	static const auto posBegin = 0, posEnd = 4, lenDir = 3;
 
-	std::smatch match; 
-	if (!std::regex_match(group, match, varWindRgx)) return notRecognised; 
+	if (group.length() != posEnd + lenDir || group[lenDir] != 'V') 
+		return notRecognised;
+	if (!strToUint(group, posBegin, lenDir).has_value() ||
+		!strToUint(group, posEnd, lenDir).has_value()) return notRecognised;
 	WindGroup result;
-	const auto begin = Direction::fromDegreesString(match.str(matchVarWindBegin));
+	const auto begin = Direction::fromDegreesString(group.substr(posBegin, lenDir));
 	if (!begin.has_value()) return notRecognised;
 	result.vsecBegin = *begin;
-	const auto end = Direction::fromDegreesString(match.str(matchVarWindEnd));
+	const auto end = Direction::fromDegreesString(group.substr(posEnd, lenDir));
 	if (!end.has_value()) return notRecognised;
 	result.vsecEnd = *end;
 	result.windType = Type::VARIABLE_WIND_SECTOR;
 	return result;
 }
 
-AppendResult WindGroup::appendVariableSector(const std::string & group) {
+AppendResult WindGroup::appendVariableSector(std::string_view group) {
 	if (const auto vs = parseVariableSector(group); vs.has_value()) {
 		windType = Type::SURFACE_WIND_WITH_VARIABLE_SECTOR;
 		vsecBegin = vs->vsecBegin;
@@ -4611,40 +5104,46 @@ AppendResult WindGroup::appendVariableSector(const std::string & group) {
 	return AppendResult::NOT_APPENDED;
 }
 
-AppendResult WindGroup::appendPeakWind(const std::string & group,
+AppendResult WindGroup::appendPeakWind(std::string_view group,
 	const ReportMetadata & reportMetadata)
 {
-
-	static const std::regex pkWndRgx("(\\d\\d0)([1-9]?\\d\\d)/(\\d\\d)?(\\d\\d)");
-	static const auto matchDir = 1, matchSpeed = 2;
-	static const auto matchHour = 3, matchMinute = 4;
-
-	std::smatch match;
-	if (!std::regex_match(group, match, pkWndRgx)) return AppendResult::GROUP_INVALIDATED;
+	//static const std::regex pkWndRgx("(\\d\\d0)([1-9]?\\d\\d)/(\\d\\d)?(\\d\\d)");
+	static const auto posDir = 0, lenDir = 3, posSpeed = 3;
+
+	const auto slashPos = group.find('/');
+	if (slashPos == std::string::npos) return AppendResult::GROUP_INVALIDATED;
+	const auto timeLen = group.length() - slashPos - 1;
+	if (!strToUint(group, posDir, lenDir).has_value() || group[lenDir - 1] != '0' ||
+		slashPos < posSpeed + 2 || slashPos > posSpeed + 3 ||
+		(slashPos == posSpeed + 3 && group[posSpeed] == '0') ||
+		!strToUint(group, posSpeed, slashPos - posSpeed).has_value() ||
+		(timeLen != 2 && timeLen != 4)) return AppendResult::GROUP_INVALIDATED;
+	const auto time = strToUint(group, slashPos + 1, timeLen);
+	if (!time.has_value()) return AppendResult::GROUP_INVALIDATED;
 
 	windType = Type::PEAK_WIND;
-	const auto dir = Direction::fromDegreesString(match.str(matchDir));
+	const auto dir = Direction::fromDegreesString(group.substr(posDir, lenDir));
 	if (!dir.has_value()) return AppendResult::GROUP_INVALIDATED;
 	windDir = *dir;
 
-	const auto speed =
-		Speed::fromString(match.str(matchSpeed), Speed::Unit::KNOTS);
+	const auto speed = Speed::fromString(
+		group.substr(posSpeed, slashPos - posSpeed), Speed::Unit::KNOTS);
 	if (!speed.has_value()) return AppendResult::GROUP_INVALIDATED;
 	wSpeed = *speed;
 
-	if (!reportMetadata.reportTime.has_value() && match.str(matchHour).empty()) {
+	if (!reportMetadata.reportTime.has_value() && timeLen == 2) {
 		return AppendResult::GROUP_INVALIDATED;
 	}
-	const auto hour = match.str(matchHour).empty() ?
-		reportMetadata.reportTime->hour() : stoi(match.str(matchHour));
-	const auto minute = stoi(match.str(matchMinute));
+	const auto hour = (timeLen == 2) ?
+		reportMetadata.reportTime->hour() : (*time / 100);
+	const auto minute = *time % 100;
 	evTime = MetafTime(hour, minute);
 	incompleteText = IncompleteText::NONE;
 
 	return AppendResult::APPENDED;
 }
 
-AppendResult WindGroup::appendWindShift(const std::string & group,
+AppendResult WindGroup::appendWindShift(std::string_view group,
 	const ReportMetadata & reportMetadata)
 {
 	//Append FROPA to wind shift group with or without time
@@ -4693,7 +5192,7 @@ bool WindGroup::isValid() const {
 
 ///////////////////////////////////////////////////////////////////////////
 
-std::optional<VisibilityGroup> VisibilityGroup::parse(const std::string & group,
+std::optional<VisibilityGroup> VisibilityGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4727,7 +5226,7 @@ std::optional<VisibilityGroup> VisibilityGroup::parse(const std::string & group,
 	return std::optional<VisibilityGroup>();
 }
 
-AppendResult VisibilityGroup::append(const std::string & group,
+AppendResult VisibilityGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -4829,7 +5328,7 @@ AppendResult VisibilityGroup::append(const std::string & group,
 }
 
 std::optional<VisibilityGroup> VisibilityGroup::fromIncompleteInteger(
-	const std::string & group)
+	std::string_view group)
 {
 	static const std::optional<VisibilityGroup> error;
 	VisibilityGroup	result;
@@ -4840,52 +5339,96 @@ std::optional<VisibilityGroup> VisibilityGroup::fromIncompleteInteger(
 }
 
 std::optional<VisibilityGroup> VisibilityGroup::fromMeters(
-	const std::string & group)
+	std::string_view group)
 {
 	static const std::optional<VisibilityGroup> notRecognised;
-	static const std::regex rgx("(\\d\\d\\d\\d|////)([NSWE][WED]?[V]?)?");
-	static const auto matchVis = 1, matchDir = 2;
-	std::smatch match;
-	if (std::regex_match(group, match, rgx)) {
-		const auto v = Distance::fromMeterString(match.str(matchVis));
-		if (!v.has_value()) return notRecognised;
-		const auto d = Direction::fromCardinalString(match.str(matchDir));
-		VisibilityGroup result;
-		result.vis = *v;
-		result.dir = d;
-		if (result.dir.has_value()) {
-			if (result.dir->isValue()) result.visType = Type::DIRECTIONAL;
-			if (result.dir->type() == Direction::Type::NDV) result.visType = Type::PREVAILING_NDV;
-		}
-		return result;
+	//static const std::regex rgx("(\\d\\d\\d\\d|////)([NSWE][WED]?[V]?)?");
+	static const auto posVis = 0, lenVis = 4;
+	if (group.length() < lenVis || group.length() > lenVis + 3) return notRecognised;
+	std::size_t pos = lenVis;
+	if (pos < group.length()) {
+		if (!isCharOf(group[pos], "NSWE")) return notRecognised;
+		pos++;
+		if (pos < group.length() && isCharOf(group[pos], "WED")) pos++;
+		if (pos < group.length() && group[pos] == 'V') pos++;
+		if (pos != group.length()) return notRecognised;
 	}
-	return notRecognised;
+	const auto v = Distance::fromMeterString(group.substr(posVis, lenVis));
+	if (!v.has_value()) return notRecognised;
+	const auto d = Direction::fromCardinalString(group.substr(lenVis));
+	VisibilityGroup result;
+	result.vis = *v;
+	result.dir = d;
+	if (result.dir.has_value()) {
+		if (result.dir->isValue()) result.visType = Type::DIRECTIONAL;
+		if (result.dir->type() == Direction::Type::NDV) result.visType = Type::PREVAILING_NDV;
+	}
+	return result;
 }
 
-std::optional<VisibilityGroup> VisibilityGroup::fromRvr(const std::string & group) {
+std::optional<VisibilityGroup> VisibilityGroup::fromRvr(std::string_view group) {
 	static const std::optional<VisibilityGroup> notRecognised;
-	static const std::regex rgx("(R\\d\\d[RCL]?|R//)/(////|[PM]?\\d\\d\\d\\d)"
-		"(?:V([PM]?\\d\\d\\d\\d))?(FT/?)?([UND/])?");
-	static const auto matchRunway = 1, matchRvr = 2, matchVarRvr = 3, matchUnit = 4;
-	static const auto matchTrend = 5;
-	std::smatch match;
-	if (!regex_match(group, match, rgx)) return notRecognised;
-	const bool unitFeet = match.length(matchUnit);
-	if (match.str(matchRunway) == "R//" && match.str(matchRvr) != "////")
+	//static const std::regex rgx("(R\\d\\d[RCL]?|R//)/(////|[PM]?\\d\\d\\d\\d)"
+	//	"(?:V([PM]?\\d\\d\\d\\d))?(FT/?)?([UND/])?");
+	static const auto lenRvr = 4;
+	// Scans [PM]?\d\d\d\d starting at pos, returns length or 0 if no match
+	static const auto rvrLength = [](std::string_view s, std::size_t pos) {
+		const auto lenMod = (pos < s.length() && (s[pos] == 'P' || s[pos] == 'M')) ? 1u : 0u;
+		if (!strToUint(s, pos + lenMod, lenRvr).has_value()) return 0u;
+		return lenMod + lenRvr;
+	};
+
+	if (group.length() < 3 || group[0] != 'R') return notRecognised;
+	std::size_t pos = 3;
+	if (isDigit(group[1]) && isDigit(group[2])) {
+		if (pos < group.length() && isCharOf(group[pos], "RCL")) pos++;
+	} else {
+		if (group[1] != '/' || group[2] != '/') return notRecognised;
+	}
+	const auto runwayStr = group.substr(0, pos);
+	if (pos >= group.length() || group[pos++] != '/') return notRecognised;
+
+	auto rvrLen = rvrLength(group, pos);
+	if (!rvrLen && isSlashStr(group, pos, lenRvr)) rvrLen = lenRvr;
+	if (!rvrLen) return notRecognised;
+	const auto rvrStr = group.substr(pos, rvrLen);
+	pos += rvrLen;
+
+	std::string_view varRvrStr;
+	if (pos < group.length() && group[pos] == 'V') {
+		const auto varRvrLen = rvrLength(group, ++pos);
+		if (!varRvrLen) return notRecognised;
+		varRvrStr = group.substr(pos, varRvrLen);
+		pos += varRvrLen;
+	}
+
+	bool unitFeet = false;
+	if (pos + 1 < group.length() && group[pos] == 'F' && group[pos + 1] == 'T') {
+		unitFeet = true;
+		pos += 2;
+		if (pos < group.length() && group[pos] == '/') pos++;
+	}
+
+	std::string_view trendStr;
+	if (pos < group.length() && isCharOf(group[pos], "UND/")) 
+		trendStr = group.substr(pos++, 1);
+	if (pos != group.length()) return notRecognised;
+
+	if (runwayStr == "R//" && rvrStr != "////")
 		return notRecognised;
-	if (match.str(matchRunway) == "R//" && match.str(matchTrend) == "/")
+	if (runwayStr == "R//" && trendStr == "/")
 		return notRecognised;
-	const auto runway = Runway::fromString(match.str(matchRunway));
-	if (!runway.has_value() && match.str(matchRunway) != "R//") return notRecognised;
-	const auto rvr = Distance::fromRvrString(match.str(matchRvr), unitFeet);
+	const auto runway = Runway::fromString(runwayStr);
+	if (!runway.has_value() && runwayStr != "R//") return notRecognised;
+	const auto rvr = Distance::fromRvrString(rvrStr, unitFeet);
 	if (!rvr.has_value()) return notRecognised;
 	VisibilityGroup result;
 	result.visType = Type::RVR;
 	result.rw = runway;
 	result.vis = *rvr;
-	result.rvrTrend = trendFromString(match.str(matchTrend));
-	if (match.length(matchVarRvr)) {
-		const auto varRvr = Distance::fromRvrString(match.str(matchVarRvr), unitFeet);
+	result.rvrTrend = trendFromString(trendStr);
+	if (!varRvrStr.empty()) {
+		const auto varRvr = Distance::fromRvrString(varRvrStr, unitFeet);
 		if (!varRvr.has_value()) return notRecognised;
 		result.visType = Type::VARIABLE_RVR;
 		result.visMax = *varRvr;
@@ -4893,7 +5436,7 @@ std::optional<VisibilityGroup> VisibilityGroup::fromRvr(const std::string & grou
 	return result;
 }
 
-bool VisibilityGroup::appendFractionToIncompleteInteger(const std::string & group, 
+bool VisibilityGroup::appendFractionToIncompleteInteger(std::string_view group, 
 	IncompleteText next)
 {
 	const auto v = Distance::fromMileString(group); 
@@ -4906,7 +5449,7 @@ bool VisibilityGroup::appendFractionToIncompleteInteger(const std::string & grou
 }
 
 
-bool VisibilityGroup::appendDirection(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendDirection(std::string_view group, IncompleteText next) {
 	if (const auto d = Direction::fromCardinalString(group); d.has_value()) {
 		dir = d;
 		if (visType == Type::PREVAILING) visType = Type::DIRECTIONAL;
@@ -4923,7 +5466,7 @@ bool VisibilityGroup::appendDirection(const std::string & group, IncompleteText
 	return false;
 }
 
-bool VisibilityGroup::appendRunway(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendRunway(std::string_view group, IncompleteText next) {
 	const auto r = Runway::fromString(group, true);
 	if (!r.has_value()) return false;
 	rw = r;
@@ -4933,7 +5476,7 @@ bool VisibilityGroup::appendRunway(const std::string & group, IncompleteText nex
 	return true;
 }
 
-bool VisibilityGroup::appendInteger(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendInteger(std::string_view group, IncompleteText next) {
 	if (group.empty() || group.length() > 3) return false;
 	if (group.find('/') != std::string::npos) return false;
 	if (vis.isReported()) return false;
@@ -4944,7 +5487,7 @@ bool VisibilityGroup::appendInteger(const std::string & group, IncompleteText ne
 	return true;
 }
 
-bool VisibilityGroup::appendFraction(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendFraction(std::string_view group, IncompleteText next) {
 	if (group.find('/') == std::string::npos) return false;
 	const auto v = Distance::fromMileString(group, true);
 	if (!v.has_value()) return false;
@@ -4959,7 +5502,7 @@ bool VisibilityGroup::appendFraction(const std::string & group, IncompleteText n
 	return true;
 }
 
-bool VisibilityGroup::appendVariableMaxFraction(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendVariableMaxFraction(std::string_view group, IncompleteText next) {
 	const auto fraction = fractionStrToUint(group, 0, group.length());
 	if (!fraction.has_value()) return false;
 	const auto numerator = std::get<0>(*fraction);
@@ -4973,7 +5516,7 @@ bool VisibilityGroup::appendVariableMaxFraction(const std::string & group, Incom
 	return true;
 }
 
-bool VisibilityGroup::appendVariable(const std::string & group,
+bool VisibilityGroup::appendVariable(std::string_view group,
 	IncompleteText nextIfMaxIsInteger,
 	IncompleteText nextIfMaxIsFraction)
 {
@@ -5002,7 +5545,7 @@ bool VisibilityGroup::appendVariable(const std::string & group,
 	return true;
 }
 
-bool VisibilityGroup::appendMeters(const std::string & group, IncompleteText next) {
+bool VisibilityGroup::appendMeters(std::string_view group, IncompleteText next) {
 	const auto v = Distance::fromMeterString(group);
 	if (!v.has_value()) return false;
 	if (!v->isReported()) return false;
@@ -5011,14 +5554,13 @@ bool VisibilityGroup::appendMeters(const std::string & group, IncompleteText nex
 	return true;
 }
 
-bool VisibilityGroup::appendVariableMeters(const std::string & group, IncompleteText next) {
-	static const std::regex rgx("(\\d\\d\\d\\d)V(\\d\\d\\d\\d)");
-	static const auto matchMin = 1, matchMax = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return false;
-	const auto min = Distance::fromMeterString(match.str(matchMin));
+bool VisibilityGroup::appendVariableMeters(std::string_view group, IncompleteText next) {
+	//static const std::regex rgx("(\\d\\d\\d\\d)V(\\d\\d\\d\\d)");
+	static const auto posMin = 0, posMax = 5, lenVis = 4;
+	if (group.length() != posMax + lenVis || group[lenVis] != 'V') return false;
+	const auto min = Distance::fromMeterString(group.substr(posMin, lenVis));
 	if (!min.has_value()) return false;
-	const auto max = Distance::fromMeterString(match.str(matchMax));
+	const auto max = Distance::fromMeterString(group.substr(posMax, lenVis));
 	if (!max.has_value()) return false;
 	if (!min->isReported() || !max->isReported()) return false;
 	vis = *min;
@@ -5028,7 +5570,7 @@ bool VisibilityGroup::appendVariableMeters(const std::string & group, Incomplete
 	return true;
 }
 
-VisibilityGroup::Trend VisibilityGroup::trendFromString(const std::string & s) {
+VisibilityGroup::Trend VisibilityGroup::trendFromString(std::string_view s) {
 	if (s == "/") return Trend::NOT_REPORTED;
 	if (s == "U") return Trend::UPWARD;
 	if (s == "N") return Trend::NEUTRAL;
@@ -5051,7 +5593,7 @@ bool VisibilityGroup::isValid() const {
 
 ///////////////////////////////////////////////////////////////////////////
 
-std::optional<CloudGroup> CloudGroup::parse(const std::string & group,
+std::optional<CloudGroup> CloudGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5073,7 +5615,7 @@ std::optional<CloudGroup> CloudGroup::parse(const std::string & group,
 	return std::optional<CloudGroup>();
 }
 
-AppendResult CloudGroup::append(const std::string & group,
+AppendResult CloudGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5108,7 +5650,7 @@ AppendResult CloudGroup::append(const std::string & group,
 	}
 }
 
-std::optional<CloudGroup> CloudGroup::parseCloudLayerOrVertVis(const std::string & s) {
+std::optional<CloudGroup> CloudGroup::parseCloudLayerOrVertVis(std::string_view s) {
 	static const std::optional<CloudGroup> notRecognised;
 	// Attempt to parse 'no cloud' groups
 	if (s == "NCD") return CloudGroup(Type::NO_CLOUDS, Amount::NCD);
@@ -5116,17 +5658,20 @@ std::optional<CloudGroup> CloudGroup::parseCloudLayerOrVertVis(const std::string
 	if (s == "CLR") return CloudGroup(Type::NO_CLOUDS, Amount::NONE_CLR);
 	if (s == "SKC") return CloudGroup(Type::NO_CLOUDS, Amount::NONE_SKC);
 	//Attempt to parse cloud layer or vertical visibility
-	std::smatch match;
-	static const std::regex rgx(
-		"([A-Z][A-Z][A-Z]?|///)(\\d\\d\\d|///)([CT][BC][U]?|///)?");
-	static const auto matchAmount = 1, matchHeight = 2, matchCnvType = 3;
-	if (!std::regex_match(s, match, rgx)) return notRecognised;
-
-	const auto amount = amountFromString(match.str(matchAmount));
+	//static const std::regex rgx(
+	//	"([A-Z][A-Z][A-Z]?|///)(\\d\\d\\d|///)([CT][BC][U]?|///)?");
+	static const auto lenHeight = 3;
+	if (s.length() < 3) return notRecognised;
+	// Amount is 2 chars (VV) or 3 chars (FEW, SCT, BKN, OVC, ///)
+	const auto lenAmount = 
+		(isUpperLetter(s[0]) && isUpperLetter(s[1]) && !isUpperLetter(s[2])) ? 2u : 3u;
+	if (s.length() < lenAmount + lenHeight) return notRecognised;
+
+	const auto amount = amountFromString(s.substr(0, lenAmount));
 	if (!amount.has_value()) return notRecognised;
-	const auto height = Distance::fromHeightString(match.str(matchHeight));
+	const auto height = Distance::fromHeightString(s.substr(lenAmount, lenHeight));
 	if (!height.has_value()) return notRecognised;
-	const auto cnvtype = convectiveTypeFromString(match.str(matchCnvType));
+	const auto cnvtype = convectiveTypeFromString(s.substr(lenAmount + lenHeight));
 	if (!cnvtype.has_value()) return notRecognised;
 
 	// If vertical visibility is given, convective cloud type must not be specified
@@ -5142,24 +5687,27 @@ std::optional<CloudGroup> CloudGroup::parseCloudLayerOrVertVis(const std::string
 	return result;
 }
 
-std::optional<CloudGroup> CloudGroup::parseVariableCloudLayer(const std::string & s) {
+std::optional<CloudGroup> CloudGroup::parseVariableCloudLayer(std::string_view s) {
 	static const std::optional<CloudGroup> notRecognised;
-
-	std::smatch match;
-	static const std::regex rgx("([A-Z][A-Z][A-Z])(\\d\\d\\d)?");
-	static const auto matchAmount = 1, matchHeight = 2;
-	if (!std::regex_match(s, match, rgx)) return notRecognised;
+	//static const std::regex rgx("([A-Z][A-Z][A-Z])(\\d\\d\\d)?");
+	static const auto lenAmount = 3, lenHeight = 3;
+	if (s.length() != lenAmount && s.length() != lenAmount + lenHeight)
+		return notRecognised;
+	if (!isUpperLetter(s[0]) || !isUpperLetter(s[1]) || !isUpperLetter(s[2]))
+		return notRecognised;
+	if (s.length() > lenAmount && !strToUint(s, lenAmount, lenHeight).has_value())
+		return notRecognised;
 
 	CloudGroup result;
 	result.tp = Type::CLOUD_LAYER;
 	result.incompleteText = IncompleteText::RMK_AMOUNT;
 
-	const auto amount = amountFromString(match.str(matchAmount));
-	// Not checking for VV here because 3-char amount length guaranteed by regex
+	const auto amount = amountFromString(s.substr(0, lenAmount));
+	// Not checking for VV here because 3-char amount length checked above
 	if (!amount.has_value()) return notRecognised;
 	result.amnt = *amount;
 
-	if (const std::string heightStr = match.str(matchHeight); !heightStr.empty()) {
+	if (const auto heightStr = s.substr(lenAmount); !heightStr.empty()) {
 		const auto height = Distance::fromHeightString(heightStr);
 		if (!height.has_value()) return notRecognised;
 		result.heightOrVertVis = *height;
@@ -5223,7 +5771,7 @@ std::optional<CloudType> CloudGroup::cloudType() const {
 	}
 }
 
-std::optional<CloudGroup::Amount> CloudGroup::amountFromString(const std::string & s) {
+std::optional<CloudGroup::Amount> CloudGroup::amountFromString(std::string_view s) {
 	if (s == "FEW") return CloudGroup::Amount::FEW;
 	if (s == "SCT") return CloudGroup::Amount::SCATTERED;
 	if (s == "BKN") return CloudGroup::Amount::BROKEN;
@@ -5234,7 +5782,7 @@ std::optional<CloudGroup::Amount> CloudGroup::amountFromString(const std::string
 }
 
 std::optional<CloudGroup::ConvectiveType> CloudGroup::convectiveTypeFromString(
-	const std::string & s)
+	std::string_view s)
 {
 	if (s.empty()) return ConvectiveType::NONE;
 	if (s == "TCU") return ConvectiveType::TOWERING_CUMULUS;
@@ -5243,7 +5791,7 @@ std::optional<CloudGroup::ConvectiveType> CloudGroup::convectiveTypeFromString(
 	return std::optional<ConvectiveType>();
 }
 
-AppendResult CloudGroup::appendVariableCloudAmount(const std::string & group) {
+AppendResult CloudGroup::appendVariableCloudAmount(std::string_view group) {
 	const auto newAmount = amountFromString(group); 
 	if (!newAmount.has_value()) return AppendResult::GROUP_INVALIDATED;
 	const auto a1 = amount();
@@ -5258,20 +5806,22 @@ AppendResult CloudGroup::appendVariableCloudAmount(const std::string & group) {
 	return AppendResult::APPENDED;
 }
 
-AppendResult CloudGroup::appendCeiling(const std::string & group) {
+AppendResult CloudGroup::appendCeiling(std::string_view group) {
 	if (const auto d = Distance::fromHeightString(group); d.has_value()) {
 		if (!d->isReported()) return AppendResult::GROUP_INVALIDATED;
 		heightOrVertVis = *d;
 		incompleteText = IncompleteText::CIG_NUM;
 		return AppendResult::APPENDED;
 	}
-	static const std::regex rgx ("(\\d\\d\\d)V(\\d\\d\\d)");
-	static const auto matchMinHeight = 1, matchMaxHeight = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return AppendResult::GROUP_INVALIDATED;
-	const auto minH = Distance::fromHeightString(match.str(matchMinHeight));
+	//static const std::regex rgx ("(\\d\\d\\d)V(\\d\\d\\d)");
+	static const auto posMinHeight = 0, posMaxHeight = 4, lenHeight = 3;
+	if (group.length() != posMaxHeight + lenHeight || group[lenHeight] != 'V' ||
+		!strToUint(group, posMinHeight, lenHeight).has_value() ||
+		!strToUint(group, posMaxHeight, lenHeight).has_value())
+			return AppendResult::GROUP_INVALIDATED;
+	const auto minH = Distance::fromHeightString(group.substr(posMinHeight, lenHeight));
 	if (!minH.has_value()) return AppendResult::GROUP_INVALIDATED;
-	const auto maxH = Distance::fromHeightString(match.str(matchMaxHeight));
+	const auto maxH = Distance::fromHeightString(group.substr(posMaxHeight, lenHeight));
 	if (!maxH.has_value()) return AppendResult::GROUP_INVALIDATED;
 	heightOrVertVis = *minH;
 	maxHt = *maxH;
@@ -5280,7 +5830,7 @@ AppendResult CloudGroup::appendCeiling(const std::string & group) {
 	return AppendResult::APPENDED;
 }
 
-AppendResult CloudGroup::appendRunwayOrCardinalDirection(const std::string & group) {
+AppendResult CloudGroup::appendRunwayOrCardinalDirection(std::string_view group) {
 	incompleteText = IncompleteText::NONE;
 	rw = Runway::fromString(group, true);
 	if (rw.has_value()) return AppendResult::APPENDED;
@@ -5289,16 +5839,18 @@ AppendResult CloudGroup::appendRunwayOrCardinalDirection(const std::string & gro
 	return AppendResult::NOT_APPENDED;
 }
 
-AppendResult CloudGroup::appendObscuration(const std::string & group) {
-	static const std::regex rgx("([A-Z][A-Z][A-Z])(\\d\\d\\d)");
-	static const auto matchAmount = 1, matchHeight = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return AppendResult::GROUP_INVALIDATED;
+AppendResult CloudGroup::appendObscuration(std::string_view group) {
+	//static const std::regex rgx("([A-Z][A-Z][A-Z])(\\d\\d\\d)");
+	static const auto lenAmount = 3, lenHeight = 3;
+	if (group.length() != lenAmount + lenHeight ||
+		!isUpperLetter(group[0]) || !isUpperLetter(group[1]) || !isUpperLetter(group[2]) ||
+		!strToUint(group, lenAmount, lenHeight).has_value())
+			return AppendResult::GROUP_INVALIDATED;
 
-	const auto h = Distance::fromHeightString(match.str(matchHeight));
+	const auto h = Distance::fromHeightString(group.substr(lenAmount, lenHeight));
 	if (!h.has_value()) return AppendResult::GROUP_INVALIDATED;
 
-	const auto a = amountFromString(match.str(matchAmount));
+	const auto a = amountFromString(group.substr(0, lenAmount));
 	if (!a.has_value()) return AppendResult::GROUP_INVALIDATED;
 
 	amnt = *a;
@@ -5310,7 +5862,7 @@ AppendResult CloudGroup::appendObscuration(const std::string & group) {
 
 ///////////////////////////////////////////////////////////////////////////
 
-std::optional<WeatherGroup> WeatherGroup::parse(const std::string & group,
+std::optional<WeatherGroup> WeatherGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5319,8 +5871,7 @@ std::optional<WeatherGroup> WeatherGroup::parse(const std::string & group,
 		if (group == "NSW") return WeatherGroup(Type::NSW);
 		if (const auto wp = parseWeatherWithoutEvent(group, reportPart); wp.has_value()) {
 			WeatherGroup result;
-			result.w[0] = *wp;
-			result.wsz = 1;
+			result.w.push_back(*wp);
 			if (wp->qualifier() == WeatherPhenomena::Qualifier::RECENT) result.t = Type::RECENT;
 			return result;
 		}
@@ -5336,7 +5887,7 @@ std::optional<WeatherGroup> WeatherGroup::parse(const std::string & group,
 	return notRecognised;
 }
 
-AppendResult WeatherGroup::append(const std::string & group,
+AppendResult WeatherGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5380,13 +5931,13 @@ AppendResult WeatherGroup::append(const std::string & group,
 
 inline std::vector<WeatherPhenomena> WeatherGroup::weatherPhenomena() const {
 	std::vector<WeatherPhenomena> result;
-	for (auto i=0u; i < wsz; i++) 
+	for (auto i=0u; i < w.size(); i++) 
 		result.push_back(w[i]);
 	return result;
 }
 
 std::optional<WeatherPhenomena> WeatherGroup::parseWeatherWithoutEvent(
-	const std::string & group, 
+	std::string_view group, 
 	ReportPart reportPart)
 {
 	std::optional<WeatherPhenomena> notRecognised;
@@ -5404,7 +5955,7 @@ std::optional<WeatherPhenomena> WeatherGroup::parseWeatherWithoutEvent(
 	return wp;
 }
 
-std::optional<WeatherGroup> WeatherGroup::parseWeatherEvent(const std::string & group, 
+std::optional<WeatherGroup> WeatherGroup::parseWeatherEvent(std::string_view group, 
 	const MetafTime & reportTime) 
 {
 	std::optional<WeatherGroup> notRecognised;
@@ -5421,7 +5972,7 @@ std::optional<WeatherGroup> WeatherGroup::parseWeatherEvent(const std::string &
 			// i is the position after the last digit from eventStartPos
 			const auto eventLen = i - eventStartPos;
 			if (const auto minEventLen = 3; eventLen < minEventLen) return notRecognised;
-			const std::string s = group.substr(eventStartPos, eventLen);
+			const auto s = group.substr(eventStartPos, eventLen);
 			const auto w = 
 				WeatherPhenomena::fromWeatherBeginEndString(s, reportTime, previousWeather);
 			if (!w.has_value()) return notRecognised;
@@ -5432,7 +5983,7 @@ std::optional<WeatherGroup> WeatherGroup::parseWeatherEvent(const std::string &
 		lastDigit = currDigit;
 	}
 	// Last weather event in the string ends with a digit is not be detected in the loop  
-	const std::string s = group.substr(eventStartPos);
+	const auto s = group.substr(eventStartPos);
 	const auto w = 
 		WeatherPhenomena::fromWeatherBeginEndString(s, reportTime, previousWeather);
 	if (!w.has_value()) return notRecognised;
@@ -5442,9 +5993,7 @@ std::optional<WeatherGroup> WeatherGroup::parseWeatherEvent(const std::string &
 
 
 bool WeatherGroup::addWeatherPhenomena(const WeatherPhenomena & wp) {
-	if (wsz >= wSize) return false;
-	w[wsz++] = wp;
-	return true;
+	return w.push_back(wp);
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -5463,25 +6012,25 @@ bool TemperatureGroup::isValid() const {
 	return (*airTemperature().temperature() >= *dewPoint().temperature());
 }
 
-std::optional<TemperatureGroup> TemperatureGroup::parse(const std::string & group,
+std::optional<TemperatureGroup> TemperatureGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	static const std::optional<TemperatureGroup> notRecognised;
-	static const std::regex rgx("(M?\\d\\d|//)/(M?\\d\\d|//)?");
-	static const auto matchTemperature = 1, matchDewPoint = 2;
-	static const std::regex rmkRgx("T([01]\\d\\d\\d)([01]\\d\\d\\d)?");
-	static const auto rmkMatchTemperature = 1, rmkMatchDewPoint = 2;
-	std::smatch match;
+	//static const std::regex rgx("(M?\\d\\d|//)/(M?\\d\\d|//)?");
+	//static const std::regex rmkRgx("T([01]\\d\\d\\d)([01]\\d\\d\\d)?");
+	static const auto rmkPosTemperature = 1, rmkPosDewPoint = 5, rmkLen = 4;
 	if (reportPart == ReportPart::METAR) {
-		if (regex_match(group, match, rgx)) {
-			const auto t = Temperature::fromString(match.str(matchTemperature));
+		const auto sepPos = (group.length() > 1 && group[0] == '/' && group[1] == '/') ?
+			std::size_t(2) : group.find('/');
+		if (sepPos < group.length() && group[sepPos] == '/') {
+			const auto t = Temperature::fromString(group.substr(0, sepPos));
 			if (!t.has_value()) return notRecognised;
 			TemperatureGroup result(Type::TEMPERATURE_AND_DEW_POINT);
 			result.t = *t;
-			if (match.length(matchDewPoint)) {
-				const auto dp = Temperature::fromString(match.str(matchDewPoint));
+			if (sepPos + 1 < group.length()) {
+				const auto dp = Temperature::fromString(group.substr(sepPos + 1));
 				if (!dp.has_value()) return notRecognised;
 				result.dp = *dp;
 			}
@@ -5491,13 +6040,17 @@ std::optional<TemperatureGroup> TemperatureGroup::parse(const std::string & grou
 	if (reportPart == ReportPart::RMK) {
 		if (group == "T") return TemperatureGroup(Type::T_MISG, true);
 		if (group == "TD") return TemperatureGroup(Type::TD_MISG, true);
-		if (regex_match(group, match, rmkRgx)) {
-			const auto t = Temperature::fromRemarkString(match.str(rmkMatchTemperature));
+		if (group[0] == 'T' && (group.length() == rmkPosDewPoint || 
+			group.length() == rmkPosDewPoint + rmkLen))
+		{
+			const auto t = Temperature::fromRemarkString(
+				group.substr(rmkPosTemperature, rmkLen));
 			if (!t.has_value()) return notRecognised;
 			TemperatureGroup result;
 			result.t = *t;
-			if (match.length(matchDewPoint)) {
-				const auto dp = Temperature::fromRemarkString(match.str(rmkMatchDewPoint));
+			if (group.length() > rmkPosDewPoint) {
+				const auto dp = Temperature::fromRemarkString(
+					group.substr(rmkPosDewPoint, rmkLen));
 				if (!dp.has_value()) return notRecognised;
 				result.dp = *dp;
 			}
@@ -5507,7 +6060,7 @@ std::optional<TemperatureGroup> TemperatureGroup::parse(const std::string & grou
 	return notRecognised;
 }
 
-AppendResult TemperatureGroup::append(const std::string & group,
+AppendResult TemperatureGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5522,7 +6075,7 @@ AppendResult TemperatureGroup::append(const std::string & group,
 
 ///////////////////////////////////////////////////////////////////////////
 
-std::optional<PressureGroup> PressureGroup::parse(const std::string & group,
+std::optional<PressureGroup> PressureGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5566,7 +6119,7 @@ std::optional<PressureGroup> PressureGroup::parse(const std::string & group,
 	return notRecognised;
 }
 
-AppendResult PressureGroup::append(const std::string & group,
+AppendResult PressureGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5581,7 +6134,7 @@ AppendResult PressureGroup::append(const std::string & group,
 
 ///////////////////////////////////////////////////////////////////////////
 
-std::optional<RunwayStateGroup> RunwayStateGroup::parse(const std::string & group,
+std::optional<RunwayStateGroup> RunwayStateGroup::parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata)
 {
@@ -5591,42 +6144,57 @@ std::optional<RunwayStateGroup> RunwayStateGroup::parse(const std::string & grou
 	if (reportPart != ReportPart::METAR) return notRecognised;
 	if (group == "SNOCLO" || group == "R/SNOCLO") 
 		return RunwayStateGroup(Type::AERODROME_SNOCLO, Runway::makeAllRunways());
-	static const std::regex rgx("(R\\d\\d[RCL]?)/(?:"
-		"(SNOCLO)|"
-		"((\\d\\d)?D)|"
-		"(?:([0-9/])([0-9/])(\\d\\d|//)|(CLRD))(\\d\\d|//))|");
-	static const auto matchRunway = 1, matchSnoclo = 2;
-	static const auto matchClrdAvc = 3, matchFrictionAvc = 4;
-	static const auto matchDeposits = 5, matchExtent = 6, matchDepth = 7;
-	static const auto matchClrd = 8, matchFriction = 9;
+	//static const std::regex rgx("(R\\d\\d[RCL]?)/(?:"
+	//	"(SNOCLO)|"
+	//	"((\\d\\d)?D)|"
+	//	"(?:([0-9/])([0-9/])(\\d\\d|//)|(CLRD))(\\d\\d|//))|");
 	static const std::string depthRunwayNotOperational = "99";
-	std::smatch match;
-	if (!regex_match(group, match, rgx)) return notRecognised;
-	const auto runway = Runway::fromString(match.str(matchRunway));
+	static const auto lenState = 6, posDepth = 2, posFriction = 4, lenValue = 2;
+	// Checks that 2 chars at pos are (\d\d|//)
+	static const auto isValueStr = [](std::string_view s, std::size_t pos) {
+		return (strToUint(s, pos, lenValue).has_value() || isSlashStr(s, pos, lenValue));
+	};
+
+	if (group.length() < 4 || group[0] != 'R' || !strToUint(group, 1, 2).has_value())
+		return notRecognised;
+	auto sepPos = 3u;
+	if (isCharOf(group[sepPos], "RCL")) sepPos++;
+	if (sepPos >= group.length() || group[sepPos] != '/') return notRecognised;
+	const auto runway = Runway::fromString(group.substr(0, sepPos));
 	if (!runway.has_value()) return notRecognised;
-	if (match.length(matchSnoclo)) 
+	const auto state = group.substr(sepPos + 1);
+
+	if (state == "SNOCLO") 
 		return RunwayStateGroup(Type::RUNWAY_SNOCLO, *runway);
-	if (match.length(matchClrdAvc)) {
+	if (state == "D" || (state.length() == 3 && state[2] == 'D')) {
 		auto fr = SurfaceFriction();
-		if (match.length(matchFrictionAvc)) {
-			const auto f = SurfaceFriction::fromString(match.str(matchFrictionAvc));
+		if (state.length() == 3) {
+			if (!strToUint(state, 0, lenValue).has_value()) return notRecognised;
+			const auto f = SurfaceFriction::fromString(state.substr(0, lenValue));
 			if (!f.has_value()) return notRecognised;
 			fr = *f;
 		}
 		return RunwayStateGroup(Type::RUNWAY_CLRD, *runway, fr);
 	}
-	const auto friction = SurfaceFriction::fromString(match.str(matchFriction));
+	if (state.length() != lenState || !isValueStr(state, posFriction)) 
+		return notRecognised;
+	const bool isClrd = (state.compare(0, posFriction, "CLRD") == 0);
+	if (!isClrd && 
+		(!isDigitOrSlash(state[0]) || !isDigitOrSlash(state[1]) ||
+		!isValueStr(state, posDepth))) return notRecognised;
+	const auto friction = SurfaceFriction::fromString(state.substr(posFriction, lenValue));
 	if (!friction.has_value()) return notRecognised;
-	if (match.length(matchClrd)) 
+	if (isClrd) 
 		return RunwayStateGroup(Type::RUNWAY_CLRD, *runway, *friction);
-	const auto deposits = depositsFromString(match.str(matchDeposits));
+	const auto deposits = depositsFromString(state.substr(0, 1));
 	if (!deposits.has_value()) return notRecognised;
-	const auto extent = extentFromString(match.str(matchExtent));
+	const auto extent = extentFromString(state.substr(1, 1));
 	if (!extent.has_value()) return notRecognised;
-	const auto depth = Precipitation::fromRunwayDeposits(match.str(matchDepth));
+	const auto depthStr = state.substr(posDepth, lenValue);
+	const auto depth = Precipitation::fromRunwayDeposits(depthStr);
 	if (!depth.has_value()) return notRecognised;
 	result.tp = Type::RUNWAY_STATE;
-	if (match.str(matchDepth) == depthRunwayNotOperational) {
+	if (depthStr == depthRunwayNotOperational) {
 		result.tp = Type::RUNWAY_NOT_OPERATIONAL;
 	}
 	result.rw = runway.value();
@@ -5637,7 +6205,7 @@ std::optional<RunwayStateGroup> RunwayStateGroup::parse(const std::string & grou
 	return result;
 }
 
-AppendResult RunwayStateGroup::append(const std::string & group,
+AppendResult RunwayStateGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5646,7 +6214,7 @@ AppendResult RunwayStateGroup::append(const std::string & group,
 }
 
 std::optional<RunwayStateGroup::Deposits> RunwayStateGroup::depositsFromString(
-	const std::string & s)
+	std::string_view s)
 {
 	std::optional<Deposits> error;
 	if (s.length() != 1) return error;
@@ -5667,7 +6235,7 @@ std::optional<RunwayStateGroup::Deposits> RunwayStateGroup::depositsFromString(
 }
 
 std::optional<RunwayStateGroup::Extent> RunwayStateGroup::extentFromString(
-	const std::string & s)
+	std::string_view s)
 {
 	std::optional<Extent> error;
 	if (s.length() != 1) return error;
@@ -5689,20 +6257,20 @@ std::optional<RunwayStateGroup::Extent> RunwayStateGroup::extentFromString(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<SeaSurfaceGroup> SeaSurfaceGroup::parse(const std::string & group,
+std::optional<SeaSurfaceGroup> SeaSurfaceGroup::parse(std::string_view group,
 		ReportPart reportPart,
 		const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	static const std::optional<SeaSurfaceGroup> notRecognised;
 	if (reportPart != ReportPart::METAR) return notRecognised;
-	static const std::regex rgx ("W(\\d\\d|//)/([HS](?:\\d\\d?\\d?|///|/))");
-	static const auto matchTemp = 1, matchWaveHeight = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-	const auto temp = Temperature::fromString(match.str(matchTemp));
+	//static const std::regex rgx ("W(\\d\\d|//)/([HS](?:\\d\\d?\\d?|///|/))");
+	static const auto posTemp = 1, lenTemp = 2, posWaveHeight = 4;
+	if (group.length() <= posWaveHeight || group[0] != 'W' || group[3] != '/')
+		return notRecognised;
+	const auto temp = Temperature::fromString(group.substr(posTemp, lenTemp));
 	if (!temp.has_value()) return notRecognised;
-	const auto waveHeight = WaveHeight::fromString(match.str(matchWaveHeight));
+	const auto waveHeight = WaveHeight::fromString(group.substr(posWaveHeight));
 	if (!waveHeight.has_value()) return notRecognised;
 	SeaSurfaceGroup result;
 	result.t = *temp;
@@ -5710,7 +6278,7 @@ std::optional<SeaSurfaceGroup> SeaSurfaceGroup::parse(const std::string & group,
 	return result;
 }
 
-AppendResult SeaSurfaceGroup::append(const std::string & group,
+AppendResult SeaSurfaceGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5721,7 +6289,7 @@ AppendResult SeaSurfaceGroup::append(const std::string & group,
 ///////////////////////////////////////////////////////////////////////////////
 
 std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::parse(
-	const std::string & group,
+	std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5734,7 +6302,7 @@ std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::parse(
 	return std::optional<MinMaxTemperatureGroup>();
 }
 
-AppendResult MinMaxTemperatureGroup::append(const std::string & group,
+AppendResult MinMaxTemperatureGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -5747,35 +6315,33 @@ AppendResult MinMaxTemperatureGroup::append(const std::string & group,
 }
 
 std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::from6hourly(
-	const std::string & group)
+	std::string_view group)
 {
 	std::optional<MinMaxTemperatureGroup> notRecognised;
-	static const std::regex rgx("([12])([01]\\d\\d\\d|////)");
-	static const auto matchType = 1, matchValue = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
+	//static const std::regex rgx("([12])([01]\\d\\d\\d|////)");
+	static const auto posValue = 1, lenValue = 4;
+	if (group.length() != posValue + lenValue) return notRecognised;
+	if (group[0] != '1' && group[0] != '2') return notRecognised;
 	MinMaxTemperatureGroup result;
 	result.t = Type::OBSERVED_6_HOURLY;
-	if (match.str(matchValue) == "////") return result;
-	const auto temp = Temperature::fromRemarkString(match.str(matchValue));
+	if (isSlashStr(group, posValue, lenValue)) return result;
+	const auto temp = Temperature::fromRemarkString(group.substr(posValue, lenValue));
 	if (!temp.has_value()) return notRecognised;
-	const auto typeStr = match.str(matchType);
-	if (typeStr == "1") { result.maxTemp = *temp; }
-	if (typeStr == "2") { result.minTemp = *temp; }
+	if (group[0] == '1') { result.maxTemp = *temp; }
+	if (group[0] == '2') { result.minTemp = *temp; }
 	return result;
 }
 
 std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::from24hourly(
-	const std::string & group)
+	std::string_view group)
 {
 	std::optional<MinMaxTemperatureGroup> notRecognised;
-	static const std::regex rgx("4([01]\\d\\d\\d)([01]\\d\\d\\d)");
-	static const auto matchMax = 1, matchMin = 2;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-	const auto max = Temperature::fromRemarkString(match.str(matchMax));
+	//static const std::regex rgx("4([01]\\d\\d\\d)([01]\\d\\d\\d)");
+	static const auto posMax = 1, posMin = 5, lenValue = 4;
+	if (group.length() != posMin + lenValue || group[0] != '4') return notRecognised;
+	const auto max = Temperature::fromRemarkString(group.substr(posMax, lenValue));
 	if (!max.has_value()) return notRecognised;
-	const auto min = Temperature::fromRemarkString(match.str(matchMin));
+	const auto min = Temperature::fromRemarkString(group.substr(posMin, lenValue));
 	if (!min.has_value()) return notRecognised;
 	MinMaxTemperatureGroup result;
 	result.t = Type::OBSERVED_24_HOURLY;
@@ -5785,28 +6351,36 @@ std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::from24hourly(
 }
 
 std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::fromForecast(
-	const std::string & group)
+	std::string_view group)
 {
 	static const std::optional<MinMaxTemperatureGroup> notRecognised;
-	static const std::regex rgx ("T([XN])?(M?\\d\\d)/(\\d\\d\\d\\d)Z");
-	static const auto matchPoint = 1, matchTemperature = 2, matchTime = 3;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-	auto temp = Temperature::fromString(match.str(matchTemperature));
+	//static const std::regex rgx ("T([XN])?(M?\\d\\d)/(\\d\\d\\d\\d)Z");
+	static const auto lenTime = 4, minLenTemp = 2;
+	// Length of trailing '/', 4-digit time and 'Z'
+	static const auto lenTimeSlashZ = lenTime + 2;
+	if (group.length() < 1 + minLenTemp + lenTimeSlashZ || group[0] != 'T' || group.back() != 'Z')
+		return notRecognised;
+	const auto slashPos = group.length() - lenTimeSlashZ;
+	if (group[slashPos] != '/') return notRecognised;
+	const char point = (group[1] == 'X' || group[1] == 'N') ? group[1] : '\0';
+	const auto posTemp = point ? 2u : 1u;
+	const auto tempStr = group.substr(posTemp, slashPos - posTemp);
+	if (tempStr == "//") return notRecognised;
+	auto temp = Temperature::fromString(tempStr);
 	if (!temp.has_value()) return notRecognised;
-	auto time = MetafTime::fromStringDDHH(match.str(matchTime));
+	auto time = MetafTime::fromStringDDHH(group.substr(slashPos + 1, lenTime));
 	if (!time.has_value()) return notRecognised;
 	MinMaxTemperatureGroup result;
 	result.t = Type::FORECAST;
-	if (match.str(matchPoint) == "N") {
+	if (point == 'N') {
 		result.minTemp = *temp;
 		result.minTime = time;
 	} 
-	if (match.str(matchPoint) == "X") {
+	if (point == 'X') {
 		result.maxTemp = *temp;
 		result.maxTime = time;
 	}
-	if (!match.length(matchPoint)) {
+	if (!point) {
 		result.minTemp = *temp;
 		result.minTime = time;
 		result.maxTemp = *temp;
@@ -5816,7 +6390,7 @@ std::optional<MinMaxTemperatureGroup> MinMaxTemperatureGroup::fromForecast(
 	return result;
 }
 
-AppendResult MinMaxTemperatureGroup::append6hourly(const std::string & group) {
+AppendResult MinMaxTemperatureGroup::append6hourly(std::string_view group) {
 	static const auto error = AppendResult::NOT_APPENDED;
 	if (minTemp.isReported() && maxTemp.isReported()) return error;
 	const auto nextGroup = from6hourly(group);
@@ -5828,7 +6402,7 @@ AppendResult MinMaxTemperatureGroup::append6hourly(const std::string & group) {
 	return AppendResult::APPENDED;
 }
 
-AppendResult MinMaxTemperatureGroup::appendForecast(const std::string & group) {
+AppendResult MinMaxTemperatureGroup::appendForecast(std::string_view group) {
 	static const auto error = AppendResult::NOT_APPENDED;
 	if (minTemp.isReported() && maxTemp.isReported() && !isIncomplete) return error;
 	const auto nextGroup = fromForecast(group);
@@ -5876,30 +6450,31 @@ bool MinMaxTemperatureGroup::isValid() const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<PrecipitationGroup> PrecipitationGroup::parse(const std::string & group,
+std::optional<PrecipitationGroup> PrecipitationGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	std::optional<PrecipitationGroup> notRecognised;
-	static const std::regex rgx(
-		"([P67])(\\d\\d\\d\\d|////)|(4/|93[13]|I[136]|PP)(\\d\\d\\d|///)");
-	static const auto matchType1 = 1, matchType2 = 3;
-	static const auto matchValue1 = 2, matchValue2 = 4;
+	//static const std::regex rgx(
+	//	"([P67])(\\d\\d\\d\\d|////)|(4/|93[13]|I[136]|PP)(\\d\\d\\d|///)");
+	static const auto lenValue1 = 4, lenValue2 = 3;
 
-	static const std::regex rfRgx (
-		"RF(\\d\\d\\.\\d|//\\./)/(\\d\\d\\d\\.\\d|///\\./)");
-	static const auto rfMatchLast10Minutes = 1, rfMatchSince9AM = 2;
+	//static const std::regex rfRgx (
+	//	"RF(\\d\\d\\.\\d|//\\./)/(\\d\\d\\d\\.\\d|///\\./)");
+	static const auto rfPosLast10Minutes = 2, rfLenLast10Minutes = 4;
+	static const auto rfPosSince9AM = 7, rfLenSince9AM = 5;
 
-	std::smatch match;
 	PrecipitationGroup result;
 
 	if (reportPart == ReportPart::METAR) {
-		if (!std::regex_match(group, match, rfRgx)) return notRecognised;
-		const auto last10min = 
-			Precipitation::fromRainfallString(match.str(rfMatchLast10Minutes));
+		if (group.length() != rfPosSince9AM + rfLenSince9AM ||
+			group[0] != 'R' || group[1] != 'F' || 
+			group[rfPosSince9AM - 1] != '/') return notRecognised;
+		const auto last10min = Precipitation::fromRainfallString(
+			group.substr(rfPosLast10Minutes, rfLenLast10Minutes));
 		if (!last10min.has_value()) return notRecognised;
-		const auto since9AM = 
-			Precipitation::fromRainfallString(match.str(rfMatchSince9AM));
+		const auto since9AM = Precipitation::fromRainfallString(
+			group.substr(rfPosSince9AM, rfLenSince9AM));
 		if (!since9AM.has_value()) return notRecognised;
 		result.precType = Type::RAINFALL_9AM_10MIN;
 		result.precAmount = *since9AM;
@@ -5915,11 +6490,21 @@ std::optional<PrecipitationGroup> PrecipitationGroup::parse(const std::string &
 	if (group == "PCPN") return PrecipitationGroup(Type::PCPN_MISG, true);
 	if (group == "SNINCR") return PrecipitationGroup(Type::SNOW_INCREASING_RAPIDLY);
 
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-
-	// assuming only one pair matchType and matchValue will be non-empty
-	std::string typeStr = match.str(matchType1) + match.str(matchType2);
-	std::string valueStr = match.str(matchValue1) + match.str(matchValue2);
+	std::string_view typeStr;
+	if (group.length() == 1 + lenValue1 && isCharOf(group[0], "P67") &&
+		(strToUint(group, 1, lenValue1).has_value() || isSlashStr(group, 1, lenValue1)))
+	{
+		typeStr = group.substr(0, 1);
+	} else {
+		if (group.length() < lenValue2) return notRecognised;
+		typeStr = group.substr(0, group.length() - lenValue2);
+		if (typeStr != "4/" && typeStr != "931" && typeStr != "933" && 
+			typeStr != "I1" && typeStr != "I3" && typeStr != "I6" && typeStr != "PP")
+				return notRecognised;
+		if (!strToUint(group, typeStr.length(), lenValue2).has_value() &&
+			!isSlashStr(group, typeStr.length(), lenValue2)) return notRecognised;
+	}
+	const auto valueStr = group.substr(typeStr.length());
 
 	const bool is3hourly =
 		reportMetadata.reportTime.has_value() ?
@@ -5955,7 +6540,7 @@ std::optional<PrecipitationGroup> PrecipitationGroup::parse(const std::string &
 	return result;
 }
 
-AppendResult PrecipitationGroup::append(const std::string & group,
+AppendResult PrecipitationGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6011,7 +6596,7 @@ float PrecipitationGroup::factorFromType(Type type) {
 ///////////////////////////////////////////////////////////////////////////////
 
 std::optional<LayerForecastGroup::Type> LayerForecastGroup::typeFromStr(
-	const std::string & s)
+	std::string_view s)
 {
 	if (s == "60") return Type::ICING_TRACE_OR_NONE;
 	if (s == "61") return Type::ICING_LIGHT_MIXED;
@@ -6038,32 +6623,32 @@ std::optional<LayerForecastGroup::Type> LayerForecastGroup::typeFromStr(
 }
 
 std::optional<LayerForecastGroup> LayerForecastGroup::parse(
-	const std::string & group,
+	std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	std::optional<LayerForecastGroup> notRecognised;
-	static const std::regex rgx("([65][\\dX])(\\d\\d\\d\\d|////)");
-	static const auto matchType = 1, matchHeight = 2;
+	//static const std::regex rgx("([65][\\dX])(\\d\\d\\d\\d|////)");
+	static const auto lenType = 2, lenHeight = 4;
 
 	if (reportPart != ReportPart::TAF) return notRecognised;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-	const auto type = typeFromStr(match.str(matchType));
+	if (group.length() != lenType + lenHeight) return notRecognised;
+	const auto type = typeFromStr(group.substr(0, lenType));
 	if (!type.has_value()) return notRecognised;
-	const auto heights = Distance::fromLayerString(match.str(matchHeight));
-	if (!heights.has_value() && match.str(matchHeight) != "////") return notRecognised;
+	const auto heightStr = group.substr(lenType);
+	const auto heights = Distance::fromLayerString(heightStr);
+	if (!heights.has_value() && heightStr != "////") return notRecognised;
 	LayerForecastGroup result;
 	result.layerType = *type;
-	if (match.str(matchHeight) != "////") {
+	if (heightStr != "////") {
 		result.layerBaseHeight = std::get<0>(*heights);
 		result.layerTopHeight = std::get<1>(*heights);		
 	}
 	return result;
 }
 
-AppendResult LayerForecastGroup::append(const std::string & group,
+AppendResult LayerForecastGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6120,7 +6705,7 @@ std::optional<PressureTendencyGroup::Type> PressureTendencyGroup::typeFromChar(
 }
 
 std::optional<PressureTendencyGroup> PressureTendencyGroup::parse(
-	const std::string & group,
+	std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6140,14 +6725,15 @@ std::optional<PressureTendencyGroup> PressureTendencyGroup::parse(
 		return result;
 	}
 
-	static const std::regex rgx("5([\\d/])(\\d\\d\\d|///)");
-	static const auto matchType = 1, matchPressure = 2;
+	//static const std::regex rgx("5([\\d/])(\\d\\d\\d|///)");
+	static const auto posType = 1, posPressure = 2, lenPressure = 3;
 
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
-	const auto type = typeFromChar(match.str(matchType)[0]);
+	if (group.length() != posPressure + lenPressure || group[0] != '5' ||
+		!isDigitOrSlash(group[posType])) return notRecognised;
+	const auto type = typeFromChar(group[posType]);
 	if (!type.has_value()) return notRecognised;
-	const auto pressure = Pressure::fromTendencyString(match.str(matchPressure));
+	const auto pressure = 
+		Pressure::fromTendencyString(group.substr(posPressure, lenPressure));
 	if (!pressure.has_value()) return notRecognised;
 
 	PressureTendencyGroup result;
@@ -6156,7 +6742,7 @@ std::optional<PressureTendencyGroup> PressureTendencyGroup::parse(
 	return result;
 }
 
-AppendResult PressureTendencyGroup::append(const std::string & group,
+AppendResult PressureTendencyGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6168,58 +6754,69 @@ AppendResult PressureTendencyGroup::append(const std::string & group,
 
 std::vector<CloudType> CloudTypesGroup::cloudTypes() const {
 	std::vector<CloudType> result;
-	for (auto i=0u; i < cldTpSize; i++)
+	for (auto i=0u; i < cldTp.size(); i++)
 		result.push_back(cldTp[i]);
 	return result;
 }
 
-std::optional<CloudTypesGroup> CloudTypesGroup::parse(const std::string & group,
+std::optional<CloudTypesGroup> CloudTypesGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	std::optional<CloudTypesGroup> notRecognised;
 	//"(CB|TCU|CU|CF|SC|NS|ST|SF|AS|AC|ACC|CI|CS|CC|BLSN|BLDU|BLSA|IC|)(\\d)"
-	static const std::regex matchRgx("(?:(?:[A-Z]{2,4})[\\d])+");
-	static const std::regex searchRgx("[A-Z]{2,4}[\\d]");
+	//static const std::regex matchRgx("(?:(?:[A-Z]{2,4})[\\d])+");
+	//static const std::regex searchRgx("[A-Z]{2,4}[\\d]");
+	// Length of [A-Z]{2,4}\d block starting at pos, or 0 if no block there
+	static const auto blockLength = [](std::string_view s, std::size_t pos) {
+		auto len = 0u;
+		while (pos + len < s.length() && isUpperLetter(s[pos + len])) len++;
+		if (len < 2 || len > 4) return 0u;
+		if (pos + len >= s.length() || !isDigit(s[pos + len])) return 0u;
+		return len + 1;
+	};
 
 	if (reportPart != ReportPart::RMK) return notRecognised;
-	std::smatch match;
 	CloudTypesGroup result;
 	
 	if (const auto ctp = CloudType::fromString(group); ctp.has_value()) {
-		result.cldTp[0] = *ctp;
-		result.cldTpSize = 1;
+		result.cldTp.push_back(*ctp);
 		return result;
 	}
-	if (!std::regex_match(group, match, matchRgx)) return notRecognised;
-	auto iter = std::sregex_iterator(group.begin(), group.end(), searchRgx);
-	while (iter != std::sregex_iterator()) {
-		if (result.cldTpSize >= result.cldTpMaxSize) return result;
-		match = *iter++;
-		const auto ctp = CloudType::fromString(match.str(0));
+	if (group.empty()) return notRecognised;
+	for (std::size_t pos = 0; pos < group.length(); ) {
+		const auto len = blockLength(group, pos);
+		if (!len) return notRecognised;
+		pos += len;
+	}
+	for (std::size_t pos = 0; pos < group.length(); ) {
+		if (result.cldTp.size() >= cldTpMaxSize) return result;
+		const auto len = blockLength(group, pos);
+		const auto ctp = CloudType::fromString(group.substr(pos, len));
 		if (!ctp.has_value()) return notRecognised;
-		result.cldTp[result.cldTpSize++] = *ctp;
+		result.cldTp.push_back(*ctp);
+		pos += len;
 	}
 	return result;
 }
 
-AppendResult CloudTypesGroup::append(const std::string & group,
+AppendResult CloudTypesGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata; (void)group; (void)reportPart;
-	if (cldTpSize >= cldTpMaxSize) return AppendResult::NOT_APPENDED;
-	if (!cldTp[cldTpSize - 1].height().isReported()) return AppendResult::NOT_APPENDED;
+	if (cldTp.size() >= cldTpMaxSize) return AppendResult::NOT_APPENDED;
+	if (!cldTp[cldTp.size() - 1].height().isReported()) return AppendResult::NOT_APPENDED;
 	const auto ctp = CloudType::fromString(group);
 	if (!ctp.has_value()) return AppendResult::NOT_APPENDED;
 	if (!ctp->height().isReported()) return AppendResult::NOT_APPENDED;
-	cldTp[cldTpSize++] = *ctp;
+	cldTp.push_back(*ctp);
 	return AppendResult::APPENDED;
 }
 
 bool CloudTypesGroup::isValid() const {
-	for (auto i=0u; i < cldTpSize; i++)
+	for (auto i=0u; i < cldTp.size(); i++)
 		if (!cldTp[i].isValid()) return false;
 	return true;
 }
@@ -6235,22 +6832,25 @@ bool LowMidHighCloudGroup::isValid() const {
 }
 
 
-std::optional<LowMidHighCloudGroup> LowMidHighCloudGroup::parse(const std::string & group,
+std::optional<LowMidHighCloudGroup> LowMidHighCloudGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
 	std::optional<LowMidHighCloudGroup> notRecognised;
-	static const std::regex rgx("8/([0-9/])([0-9/])([0-9/])");
-	static const auto matchLowLayer = 1, matchMidLayer = 2, matchHighLayer = 3;
+	//static const std::regex rgx("8/([0-9/])([0-9/])([0-9/])");
+	static const auto posLowLayer = 2, posMidLayer = 3, posHighLayer = 4;
 
 	if (reportPart != ReportPart::RMK) return notRecognised;
-	std::smatch match;
-	if (!std::regex_match(group, match, rgx)) return notRecognised;
+	if (group.length() != posHighLayer + 1 || group[0] != '8' || group[1] != '/')
+		return notRecognised;
+	if (!isDigitOrSlash(group[posLowLayer]) || 
+		!isDigitOrSlash(group[posMidLayer]) ||
+		!isDigitOrSlash(group[posHighLayer])) return notRecognised;
 
-	const auto lowLayer = lowLayerFromChar(match.str(matchLowLayer)[0]);
-	const auto midLayer = midLayerFromChar(match.str(matchMidLayer)[0]);
-	const auto highLayer = highLayerFromChar(match.str(matchHighLayer)[0]);
+	const auto lowLayer = lowLayerFromChar(group[posLowLayer]);
+	const auto midLayer = midLayerFromChar(group[posMidLayer]);
+	const auto highLayer = highLayerFromChar(group[posHighLayer]);
 	LowMidHighCloudGroup result;
 	result.cloudLowLayer = lowLayer;
 	result.cloudMidLayer = midLayer;
@@ -6258,7 +6858,7 @@ std::optional<LowMidHighCloudGroup> LowMidHighCloudGroup::parse(const std::strin
 	return result;
 }
 
-AppendResult LowMidHighCloudGroup::append(const std::string & group,
+AppendResult LowMidHighCloudGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6317,7 +6917,7 @@ LowMidHighCloudGroup::HighLayer LowMidHighCloudGroup::highLayerFromChar(char c)
 ///////////////////////////////////////////////////////////////////////////////
 
 std::optional<LightningGroup> LightningGroup::parse(
-	const std::string & group,
+	std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6329,7 +6929,7 @@ std::optional<LightningGroup> LightningGroup::parse(
 	return fromLtgGroup(group);
 }
 
-AppendResult LightningGroup::append(const std::string & group,
+AppendResult LightningGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6382,7 +6982,7 @@ AppendResult LightningGroup::append(const std::string & group,
 	return AppendResult::NOT_APPENDED;
 }
 
-std::optional<LightningGroup> LightningGroup::fromLtgGroup(const std::string & group) {
+std::optional<LightningGroup> LightningGroup::fromLtgGroup(std::string_view group) {
 	std::optional<LightningGroup> notRecognised;
 	static const auto ltgLen = 3u; // length of string LTG
 	static const char ltg[ltgLen + 1] = "LTG";
@@ -6433,7 +7033,7 @@ std::vector<Direction> LightningGroup::directions() const {
 ///////////////////////////////////////////////////////////////////////////////
 
 std::optional<VicinityGroup> VicinityGroup::parse(
-	const std::string & group,
+	std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6462,7 +7062,7 @@ std::optional<VicinityGroup> VicinityGroup::parse(
 	return notRecognised;
 }
 
-AppendResult VicinityGroup::append(const std::string & group,
+AppendResult VicinityGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6510,7 +7110,7 @@ AppendResult VicinityGroup::append(const std::string & group,
 	}
 }
 
-bool VicinityGroup::appendDir1(const std::string & str) {
+bool VicinityGroup::appendDir1(std::string_view str) {
 	if (const auto dir = Direction::fromCardinalString(str, true); dir.has_value()) {
 		//Single direction is specified
 		dir1from = *dir;
@@ -6525,7 +7125,7 @@ bool VicinityGroup::appendDir1(const std::string & str) {
 	return false;
 }
 
-bool VicinityGroup::appendDir2(const std::string & str) {
+bool VicinityGroup::appendDir2(std::string_view str) {
 	if (const auto dir = Direction::fromCardinalString(str, true); dir.has_value()) {
 		//Single direction is specified
 		dir2from = *dir;
@@ -6540,7 +7140,7 @@ bool VicinityGroup::appendDir2(const std::string & str) {
 	return false;
 }
 
-bool VicinityGroup::appendDistance(const std::string & str) {
+bool VicinityGroup::appendDistance(std::string_view str) {
 	if (str == "DSNT") { dist = Distance::makeDistant(); return true; }
 	if (str == "VC") { dist = Distance::makeVicinity(); return true; }
 	const auto d = Distance::fromKmString(str);
@@ -6569,18 +7169,17 @@ std::vector<Direction> VicinityGroup::directions() const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-std::optional<MiscGroup> MiscGroup::parse(const std::string & group,
+std::optional<MiscGroup> MiscGroup::parse(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
 	(void)reportMetadata;
-	static const std::regex rgxSunshineDuration("98(\\d\\d\\d)");
-	static const std::regex rgxCorrectionObservation("CC([A-Z])");
-	static const auto matchValue = 1;
-	static const std::regex rgxIssuerId("F([NS])(\\d\\d\\d\\d\\d)");
-	static const auto matchIssuerStation = 1, matchIssuerId = 2;
+	//static const std::regex rgxSunshineDuration("98(\\d\\d\\d)");
+	//static const std::regex rgxCorrectionObservation("CC([A-Z])");
+	//static const std::regex rgxIssuerId("F([NS])(\\d\\d\\d\\d\\d)");
+	static const auto posSunshineDuration = 2, lenSunshineDuration = 3;
+	static const auto posIssuerId = 2, lenIssuerId = 5;
 
-	std::smatch match;
 	MiscGroup result;
 
 	if (reportPart == ReportPart::METAR || reportPart == ReportPart::RMK) {
@@ -6591,18 +7190,24 @@ std::optional<MiscGroup> MiscGroup::parse(const std::string & group,
 	}
 	
 	if (reportPart == ReportPart::TAF) {
-		if (std::regex_match(group, match, rgxIssuerId)) {
-			result.groupType = Type::ISSUER_ID_FS;
-			if (match.str(matchIssuerStation) == "N") result.groupType = Type::ISSUER_ID_FN;
-			result.groupData = std::stoi(match.str(matchIssuerId));
-			return result;
+		if (group.length() == posIssuerId + lenIssuerId && group[0] == 'F' &&
+			(group[1] == 'N' || group[1] == 'S'))
+		{
+			if (const auto id = strToUint(group, posIssuerId, lenIssuerId); id.has_value()) {
+				result.groupType = Type::ISSUER_ID_FS;
+				if (group[1] == 'N') result.groupType = Type::ISSUER_ID_FN;
+				result.groupData = *id;
+				return result;
+			}
 		}
 	}
 	
 	if (reportPart == ReportPart::METAR) {
-		if (std::regex_match(group, match, rgxCorrectionObservation)) {
+		if (group.length() == 3 && group[0] == 'C' && group[1] == 'C' &&
+			isUpperLetter(group[2]))
+		{
 			result.groupType = Type::CORRECTED_WEATHER_OBSERVATION;
-			result.groupData = match.str(matchValue)[0] - 'A' + 1;
+			result.groupData = group[2] - 'A' + 1;
 			return result;
 		}
 	}
@@ -6618,10 +7223,16 @@ std::optional<MiscGroup> MiscGroup::parse(const std::string & group,
 			result.incompleteText = IncompleteText::DENSITY;
 			return result;
 		}
-		if (std::regex_match(group, match, rgxSunshineDuration)) {
-			result.groupType = Type::SUNSHINE_DURATION_MINUTES;
-			result.groupData = std::stoi(match.str(matchValue));
-			return result;
+		if (group.length() == posSunshineDuration + lenSunshineDuration &&
+			group[0] == '9' && group[1] == '8')
+		{
+			const auto duration = 
+				strToUint(group, posSunshineDuration, lenSunshineDuration);
+			if (duration.has_value()) {
+				result.groupType = Type::SUNSHINE_DURATION_MINUTES;
+				result.groupData = *duration;
+				return result;
+			}
 		}
 		if (group == "FROIN") {
 			result.groupType = Type::FROIN;
@@ -6632,7 +7243,7 @@ std::optional<MiscGroup> MiscGroup::parse(const std::string & group,
 	return std::optional<MiscGroup>();
 }
 
-AppendResult MiscGroup::append(const std::string & group,
+AppendResult MiscGroup::append(std::string_view group,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata)
 {
@@ -6672,7 +7283,7 @@ AppendResult MiscGroup::append(const std::string & group,
 	}
 }
 
-std::optional<MiscGroup::Type> MiscGroup::parseColourCode(const std::string & group) {
+std::optional<MiscGroup::Type> MiscGroup::parseColourCode(std::string_view group) {
 	if (group == "BLU+") return Type::COLOUR_CODE_BLUE_PLUS;
 	if (group == "BLU") return Type::COLOUR_CODE_BLUE;
 	if (group == "WHT") return Type::COLOUR_CODE_WHITE;
@@ -6694,7 +7305,7 @@ std::optional<MiscGroup::Type> MiscGroup::parseColourCode(const std::string & gr
 	return std::optional<Type>();
 }
 
-bool MiscGroup::appendHailstoneFraction(const std::string & group) {
+bool MiscGroup::appendHailstoneFraction(std::string_view group) {
 	// Fraction specified with increment of 1/4
 	bool appended = false;
 	auto value = groupData.value_or(0.0);
@@ -6707,7 +7318,7 @@ bool MiscGroup::appendHailstoneFraction(const std::string & group) {
 	return true;
 }
 
-bool MiscGroup::appendDensityAltitude(const std::string & group) {
+bool MiscGroup::appendDensityAltitude(std::string_view group) {
 	static const std::string unitStr ("FT");
 	static const auto unitLen = unitStr.length();
 	if (group.length() < unitLen + 1) return false; //require at least 1 digit and FT
@@ -6755,63 +7366,190 @@ SyntaxGroup getSyntaxGroup(const Group & group) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-ParseResult Parser::parse(const std::string & report, size_t groupLimit) {
-	ReportInput in(report);
+void ParseContext::clear() {
+	for (auto & groupInfo : result.groups)
+		recycleRawString(std::move(groupInfo.rawString));
+	result.groups.clear();
+	result.reportMetadata = ReportMetadata();
+}
+
+std::string ParseContext::makeRawString(std::string_view s) {
+	if (s.length() <= inplaceRawStringCapacity || spareRawStrings.empty())
+		return std::string(s);
+	std::string rawString = std::move(spareRawStrings.back());
+	spareRawStrings.pop_back();
+	rawString.assign(s);
+	return rawString;
+}
 
-	bool reportEnd = false;
+void ParseContext::appendRawString(std::string & rawString, std::string_view s) {
+	const auto newLength = rawString.length() + 1 + s.length();
+	if (newLength > rawString.capacity() && !spareRawStrings.empty()) {
+		std::string spare = std::move(spareRawStrings.back());
+		spareRawStrings.pop_back();
+		spare.assign(rawString);
+		recycleRawString(std::move(rawString));
+		rawString = std::move(spare);
+	}
+	rawString += groupDelimiterChar;
+	rawString += s;
+}
+
+void ParseContext::recycleRawString(std::string && s) {
+	if (s.capacity() <= inplaceRawStringCapacity) return;
+	spareRawStrings.push_back(std::move(s));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ParseResult Parser::parse(std::string_view report, size_t groupLimit) {
+	ParseContext context;
+	parse(report, context, groupLimit);
+	return std::move(context.result);
+}
+
+const ParseResult & Parser::parse(std::string_view report,
+	ParseContext & context,
+	size_t groupLimit)
+{
+	context.clear();
+	ParseState state(report, groupLimit);
+	//Iterate through report groups separated by delimiters
+	while (parseNextGroup(context, state)) {}
+	return context.result;
+}
+
+const ParseResult & Parser::parseGroups(const std::vector<std::string_view> & groups,
+	ParseContext & context,
+	size_t groupLimit)
+{
+	context.clear();
+	ParseState state(ReportInput(groups.data(), groups.size()), groupLimit);
+	while (parseNextGroup(context, state)) {}
+	return context.result;
+}
+
+ReportMetadata Parser::parseMetadata(std::string_view report) {
+	ReportInput in(report);
 	Status status;
 	ReportMetadata reportMetadata;
-	ParseResult result;
-	size_t groupCount = 0;
+	// Groups of report header may only be appended to the previous group,
+	// no group type in report header is ever invalidated
+	Group lastGroup = FallbackGroup();
+	// AUTO and COR may precede the first group of report body which is 
+	// not a keyword (e.g. METAR UKBB 251000Z AUTO COR 18005MPS ...)
+	const auto isLeadingKeyword = [](const Group & group) {
+		const auto keyword = std::get_if<KeywordGroup>(&group);
+		return (keyword && (keyword->type() == KeywordGroup::Type::AUTO ||
+			keyword->type() == KeywordGroup::Type::COR));
+	};
 
-	//Iterate through report groups separated by delimiters
-	std::string groupStr;
+	std::string_view groupStr;
 	in >> groupStr;
-	while (!groupStr.empty() && !reportEnd && !status.isError()) {
-
-		Group group;
+	while (!groupStr.empty() &&
+		(!status.isHeaderComplete() || isLeadingKeyword(lastGroup)))
+	{
 		ReportPart reportPart = status.getReportPart();
-		if (!appendToLastResultGroup(result, groupStr, reportPart, reportMetadata)) {
-			// Current group was not appended to last group
+		// Same as in appendToLastResultGroup(), never append to fallback group
+		const bool appended = !std::holds_alternative<FallbackGroup>(lastGroup) &&
+			std::visit([&](auto && gr) {
+				return gr.append(groupStr, reportPart, reportMetadata);
+			}, lastGroup) == AppendResult::APPENDED;
+		if (!appended) {
 			do {
-				// Group may be parsed multiple times because at this point 
-				// parser may not know yet if the report is METAR or TAF
-				// and reportPart may change based on report type.
 				reportPart = status.getReportPart(); 
-				group = GroupParser::parse(groupStr, reportPart, reportMetadata);
-				status.transition(getSyntaxGroup(group));
-				groupCount++;
-				if (groupCount >= groupLimit) status.setError(ReportError::REPORT_TOO_LARGE);
+				lastGroup = GroupParser::parseOnly<KeywordGroup, 
+					LocationGroup, 
+					ReportTimeGroup, 
+					TrendGroup>(groupStr, reportPart, reportMetadata);
+				status.transition(getSyntaxGroup(lastGroup));
 			} while(status.isReparseRequired()  && !status.isError());
-			updateMetadata(group, reportMetadata);
-			addGroupToResult(result, std::move(group), reportPart, std::move(groupStr));
-		} else {
-			// Raw string was appended to the group, just increase group count
-			groupCount++;
-			if (groupCount >= groupLimit) status.setError(ReportError::REPORT_TOO_LARGE);
+			updateMetadata(lastGroup, reportMetadata);
 		}
-		
 		in >> groupStr;
 	}
+	status.finalTransition();
+	reportMetadata.type = status.getReportType();
+	reportMetadata.error = status.getError();
+	return reportMetadata;
+}
+
+LazyParseResult Parser::parseLazy(std::string_view report, size_t groupLimit) {
+	LazyParseResult lazyResult;
+	parseLazy(report, lazyResult, groupLimit);
+	return lazyResult;
+}
+
+void Parser::parseLazy(std::string_view report,
+	LazyParseResult & lazyResult,
+	size_t groupLimit)
+{
+	lazyResult.context.clear();
+	lazyResult.state = ParseState(report, groupLimit);
+}
+
+// Parses next group string of the report; when there are no more group 
+// strings to parse, completes the result and returns false
+bool Parser::parseNextGroup(ParseContext & context, ParseState & state) {
+	if (state.finished) return false;
+	std::string_view groupStr;
+	state.input >> groupStr;
+	Status & status = state.status;
+	if (groupStr.empty() || status.isError()) {
+		finishParse(context, state);
+		return false;
+	}
+
+	const ReportMetadata & reportMetadata = state.reportMetadata;
+	Group group;
+	ReportPart reportPart = status.getReportPart();
+	if (!appendToLastResultGroup(context, groupStr, reportPart, reportMetadata)) {
+		// Current group was not appended to last group
+		do {
+			// Group may be parsed multiple times because at this point 
+			// parser may not know yet if the report is METAR or TAF
+			// and reportPart may change based on report type.
+			reportPart = status.getReportPart(); 
+			group = GroupParser::parse(groupStr, reportPart, reportMetadata);
+			status.transition(getSyntaxGroup(group));
+			state.groupCount++;
+			if (state.groupCount >= state.groupLimit) 
+				status.setError(ReportError::REPORT_TOO_LARGE);
+		} while(status.isReparseRequired()  && !status.isError());
+		updateMetadata(group, state.reportMetadata);
+		addGroupToResult(context, std::move(group), reportPart, groupStr);
+	} else {
+		// Raw string was appended to the group, just increase group count
+		state.groupCount++;
+		if (state.groupCount >= state.groupLimit) 
+			status.setError(ReportError::REPORT_TOO_LARGE);
+	}
+	return true;
+}
+
+void Parser::finishParse(ParseContext & context, ParseState & state) {
+	state.finished = true;
+	ParseResult & result = context.result;
+	Status & status = state.status;
 	if (!result.groups.empty()) {
 		// if last group is incomplete, invalidate it by adding an empty string
-		appendToLastResultGroup(result, "", status.getReportPart(), reportMetadata);
+		appendToLastResultGroup(context, "", status.getReportPart(), state.reportMetadata);
 		// but do not save this empty string if the group just rejects it
 		if (result.groups.back().rawString.empty()) result.groups.pop_back();
 	}
 	status.finalTransition();
-	reportMetadata.type = status.getReportType();
-	reportMetadata.error = status.getError();
-	result.reportMetadata = std::move(reportMetadata);
-	return result;
+	state.reportMetadata.type = status.getReportType();
+	state.reportMetadata.error = status.getError();
+	result.reportMetadata = std::move(state.reportMetadata);
 }
 
-bool Parser::appendToLastResultGroup(ParseResult & result,
-	const std::string & groupStr,
+bool Parser::appendToLastResultGroup(ParseContext & context,
+	std::string_view groupStr,
 	ReportPart reportPart,
 	const ReportMetadata & reportMetadata,
 	bool allowReparse)
 {
+	ParseResult & result = context.result;
 	// Unable to append if this is the first group
 	if (result.groups.empty()) return false;
 
@@ -6830,8 +7568,7 @@ bool Parser::appendToLastResultGroup(ParseResult & result,
 
 	switch (appendResult) {
 		case AppendResult::APPENDED:
-		lastGroupInfo.rawString += groupDelimiterChar;
-		lastGroupInfo.rawString += groupStr;
+		context.appendRawString(lastGroupInfo.rawString, groupStr);
 		return true;
 
 		case AppendResult::NOT_APPENDED:
@@ -6843,7 +7580,8 @@ bool Parser::appendToLastResultGroup(ParseResult & result,
 			const auto prevRp = result.groups.back().reportPart;
 			const auto & prevGroup = result.groups.back().group;
 			if (!allowReparse) {
-				addGroupToResult(result, FallbackGroup(), prevRp, std::move(prevStr));
+				addGroupToResult(context, FallbackGroup(), prevRp, prevStr);
+				context.recycleRawString(std::move(prevStr));
 				return false;
 			}
 			const auto reparsed = 
@@ -6851,48 +7589,81 @@ bool Parser::appendToLastResultGroup(ParseResult & result,
 			const bool reparsedIsOtherGroup = 
 				!std::holds_alternative<FallbackGroup>(reparsed);
 			result.groups.pop_back();
-			addGroupToResult(result, std::move(reparsed), prevRp, std::move(prevStr));
+			addGroupToResult(context, std::move(reparsed), prevRp, prevStr);
+			context.recycleRawString(std::move(prevStr));
 			if (!reparsedIsOtherGroup) return false;
-			return appendToLastResultGroup(result, groupStr, reportPart, reportMetadata, false);
+			return appendToLastResultGroup(context, groupStr, reportPart, reportMetadata, false);
 		}
 	}
 }
 
-void Parser::addGroupToResult(ParseResult & result,
+void Parser::addGroupToResult(ParseContext & context,
 	Group group,
 	ReportPart reportPart,
-	std::string groupString)
+	std::string_view groupString)
 {
+	ParseResult & result = context.result;
 	if (!result.groups.empty() && std::holds_alternative<FallbackGroup>(group)) {
 		// Assumed that two fallback groups can always be appended 
 		GroupInfo & lastGroupInfo = result.groups.back();
 		if (std::get_if<FallbackGroup>(&lastGroupInfo.group)) {
-			lastGroupInfo.rawString += groupDelimiterChar;
-			lastGroupInfo.rawString += groupString;
+			context.appendRawString(lastGroupInfo.rawString, groupString);
 			return;
 		}
 	}
-	GroupInfo groupInfo(std::move(group), reportPart, groupString);
-	result.groups.push_back(std::move(groupInfo));
+	result.groups.emplace_back(std::move(group),
+		reportPart,
+		context.makeRawString(groupString));
 }
 
+///////////////////////////////////////////////////////////////////////////////
 
-std::string Parser::ReportInput::getNextGroup() {
-	if (finished) return std::string();
+const GroupInfo * LazyParseResult::group(size_t index) {
+	// Group is not final until two more groups follow it: the last group 
+	// may be extended by appending next group string, or may be invalidated 
+	// and then merged into previous group
+	const auto & groups = context.result.groups;
+	while (groups.size() <= index + 2 && 
+		Parser::parseNextGroup(context, state)) {}
+	if (index >= groups.size()) return nullptr;
+	return &groups[index];
+}
 
-	// ASCII control codes and spaces are concidered delimiters
-	while (report[pos] <= ' ') {
-		if (pos >= report.length()) {
-			finished = true;
-			return std::string();
-		}
-		pos++;
+const ParseResult & LazyParseResult::result() {
+	while (Parser::parseNextGroup(context, state)) {}
+	return context.result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::string_view Parser::ReportInput::getNextGroup() {
+	if (finished) return std::string_view();
+
+	// Each group string is scanned as a report of its own
+	while (pos >= report.length() && groupsLeft) {
+		report = *nextGroups++;
+		groupsLeft--;
+		pos = 0;
+		blockPos = std::string_view::npos;
 	}
 
-	size_t groupLen = 0;
-	while (report[pos + groupLen] > ' ') {
-		// Detect end of report or report end char 
-		if (pos >= report.length() || report[pos + groupLen] == reportEndChar) {
+	// ASCII control codes and spaces are concidered delimiters
+	// Delimiters are checked one by one within scalarLookahead chars; 
+	// longer runs of delimiters are scanned by blocks (see findNext())
+	const auto delimitersEnd = scalarLimit(pos);
+	while (pos < delimitersEnd && report[pos] <= ' ') pos++;
+	if (pos == delimitersEnd) pos = findNext(pos, false);
+	if (pos >= report.length()) {
+		finished = true;
+		return std::string_view();
+	}
+
+	// Position of group end is found by SIMD instructions if possible; the
+	// char at this position is then processed by scalar code below
+	size_t groupLen = findGroupEnd() - pos;
+	while (pos + groupLen < report.length() && report[pos + groupLen] > ' ') {
+		// Detect report end char 
+		if (report[pos + groupLen] == reportEndChar) {
 			finished = true;
 			break;
 //			return report.substr(pos, groupLen);
@@ -6907,6 +7678,142 @@ std::string Parser::ReportInput::getNextGroup() {
 	return report.substr(prevPos, groupLen);
 }
 
+// Returns position up to which the delimiters are checked by scalar code
+size_t Parser::ReportInput::scalarLimit(size_t from) const {
+	#if defined(METAF_SIMD_SSE2)
+	if (report.length() - from > scalarLookahead) return from + scalarLookahead;
+	#else
+	(void)from;
+	#endif
+	return report.length();
+}
+
+// Returns position of first delimiter, reportEndChar or '+' (except '+' 
+// in front of the group) in the group which begins at current position, 
+// or current position if this cannot be done with SIMD instructions
+size_t Parser::ReportInput::findGroupEnd() {
+	#if defined(METAF_SIMD_SSE2)
+	// Vectorised code compares chars as signed, same as scalar code does 
+	// if char is signed
+	if constexpr (std::is_signed<char>::value) {
+		if (report.length() - pos < scalarLookahead) return pos;
+		const auto c = _mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(report.data() + pos));
+		const auto notDelim = static_cast<unsigned int>(
+			_mm_movemask_epi8(_mm_cmpgt_epi8(c, _mm_set1_epi8(' '))));
+		const auto endChars = static_cast<unsigned int>(_mm_movemask_epi8(
+			_mm_cmpeq_epi8(c, _mm_set1_epi8(reportEndChar))));
+		const auto pluses = static_cast<unsigned int>(_mm_movemask_epi8(
+			_mm_cmpeq_epi8(c, _mm_set1_epi8('+'))));
+		const auto mask = (~notDelim & 0xFFFFu) | endChars | (pluses & ~1u);
+		if (mask) return pos + countTrailingZeros(mask);
+		return findNext(pos + scalarLookahead, true);
+	}
+	#endif
+	return pos;
+}
+
+// Returns position of first char which is a group end (if groupEnd is true)
+// or is not a delimiter (if groupEnd is false) starting from position 
+// 'from', or report length if there is no such char
+size_t Parser::ReportInput::findNext(size_t from, bool groupEnd) {
+	while (from < report.length()) {
+		const auto block = from - from % blockSize;
+		if (block != blockPos) loadBlock(block);
+		const auto mask = (groupEnd ? groupEnds : notDelimiters) >> (from - block);
+		if (mask) {
+			const auto result = from + countTrailingZeros(mask);
+			return (result < report.length() ? result : report.length());
+		}
+		from = block + blockSize;
+	}
+	return report.length();
+}
+
+void Parser::ReportInput::loadBlock(size_t position) {
+	blockPos = position;
+	// Chars past the end of the last block are padded with zeros; they
+	// are never returned by findNext()
+	const char * chars = report.data() + position;
+	char padded[blockSize];
+	if (const auto remaining = report.length() - position; remaining < blockSize) {
+		std::memcpy(padded, chars, remaining);
+		std::memset(padded + remaining, 0, blockSize - remaining);
+		chars = padded;
+	}
+	// Vectorised code compares chars as signed, same as scalar code does 
+	// if char is signed
+	if constexpr (std::is_signed<char>::value) {
+		#if defined(METAF_SIMD_AVX2)
+		const auto spaces = _mm256_set1_epi8(' ');
+		const auto endChars = _mm256_set1_epi8(reportEndChar);
+		const auto pluses = _mm256_set1_epi8('+');
+		std::uint64_t notDelim = 0, special = 0;
+		for (auto i = 0u; i < blockSize; i += 32) {
+			const auto c = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i *>(chars + i));
+			const auto nd = static_cast<std::uint32_t>(
+				_mm256_movemask_epi8(_mm256_cmpgt_epi8(c, spaces)));
+			const auto sp = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+				_mm256_or_si256(_mm256_cmpeq_epi8(c, endChars),
+					_mm256_cmpeq_epi8(c, pluses))));
+			notDelim |= static_cast<std::uint64_t>(nd) << i;
+			special |= static_cast<std::uint64_t>(sp) << i;
+		}
+		notDelimiters = notDelim;
+		groupEnds = ~notDelim | special;
+		return;
+		#elif defined(METAF_SIMD_SSE2)
+		const auto spaces = _mm_set1_epi8(' ');
+		const auto endChars = _mm_set1_epi8(reportEndChar);
+		const auto pluses = _mm_set1_epi8('+');
+		std::uint64_t notDelim = 0, special = 0;
+		for (auto i = 0u; i < blockSize; i += 16) {
+			const auto c = _mm_loadu_si128(
+				reinterpret_cast<const __m128i *>(chars + i));
+			const auto nd = static_cast<std::uint32_t>(
+				_mm_movemask_epi8(_mm_cmpgt_epi8(c, spaces)));
+			const auto sp = static_cast<std::uint32_t>(_mm_movemask_epi8(
+				_mm_or_si128(_mm_cmpeq_epi8(c, endChars),
+					_mm_cmpeq_epi8(c, pluses))));
+			notDelim |= static_cast<std::uint64_t>(nd) << i;
+			special |= static_cast<std::uint64_t>(sp) << i;
+		}
+		notDelimiters = notDelim;
+		groupEnds = ~notDelim | special;
+		return;
+		#endif
+	}
+	notDelimiters = 0;
+	groupEnds = 0;
+	for (auto i = 0u; i < blockSize; i++) {
+		const auto bit = std::uint64_t(1) << i;
+		if (chars[i] > ' ') notDelimiters |= bit;
+		if (chars[i] <= ' ' || chars[i] == reportEndChar || chars[i] == '+') 
+			groupEnds |= bit;
+	}
+}
+
+// Returns number of trailing zero bits; mask must not be zero
+unsigned int Parser::ReportInput::countTrailingZeros(std::uint64_t mask) {
+	#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64(&index, mask);
+	return index;
+	#elif defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	if (_BitScanForward(&index, static_cast<unsigned long>(mask))) return index;
+	_BitScanForward(&index, static_cast<unsigned long>(mask >> 32));
+	return index + 32;
+	#elif defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(mask);
+	#else
+	unsigned int result = 0;
+	while (!(mask & 1)) { mask >>= 1; result++; }
+	return result;
+	#endif
+}
+
 
 ReportPart Parser::Status::getReportPart() {
 	switch (state) {
@@ -6937,6 +7844,31 @@ ReportPart Parser::Status::getReportPart() {
 	}
 }
 
+// Returns true if subsequent groups cannot change report type, report 
+// error in report header, or NIL or CNL status of the report 
+bool Parser::Status::isHeaderComplete() {
+	switch (state) {
+		case State::REPORT_BODY_METAR:
+		case State::REPORT_BODY_TAF:
+		case State::REMARK_METAR:
+		case State::REMARK_TAF:
+		case State::ERROR:
+		return true;
+
+		case State::REPORT_TYPE_OR_LOCATION:
+		case State::CORRECTION:
+		case State::LOCATION:
+		case State::REPORT_TIME:
+		case State::TIME_SPAN:
+		case State::REPORT_BODY_BEGIN_METAR:
+		case State::REPORT_BODY_BEGIN_METAR_REPEAT_PARSE:
+		case State::REPORT_BODY_BEGIN_TAF:
+		case State::NIL:
+		case State::CNL:
+		return false;
+	}
+}
+
 void Parser::Status::transition(SyntaxGroup group) {
 	switch (state) {
 		case State::REPORT_TYPE_OR_LOCATION:
@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Ingestion of METAR and TAF archive files of any size                                     //
+//                                                                                            //
+//   Archive is memory-mapped and split into reports without copying: reports are string      //
+//   views into the mapped file. Archive is either dataserver CSV response (as saved by the   //
+//   app) or plain text with one raw report per line.                                         //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AWC_ARCHIVE_HPP
+#define AWC_ARCHIVE_HPP
+
+#include "METAF.hpp"
+#include "metaf_bulk.hpp"
+#include "metaf_mmap.hpp"
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace awc {
+
+class ArchiveReader {
+public:
+	enum class Format {
+		LINES,
+		CSV
+	};
+	using ReportHandler = std::function<void(std::string_view report,
+		const metaf::ParseResult & result)>;
+
+	// Maps the archive for sequential reading; format is CSV if the file
+	// has dataserver column header line, otherwise LINES
+	inline bool open(const std::string & path, std::string & error);
+	Format format() const { return archiveFormat; }
+	std::size_t size() const { return file.size(); }
+
+	// Passes every report to handler(stationId, rawText) in file order;
+	// station ID is empty for LINES format. Views are valid while the
+	// archive is open. Returns the number of reports.
+	template <typename Handler>
+	std::size_t forEach(Handler && handler);
+
+	// Parses reports in batches with bulk parser, handler is called in
+	// file order; only one batch of results is held in memory at a time.
+	// Report view is valid until handler returns.
+	inline std::size_t parse(metaf::BulkParser & parser,
+		const ReportHandler & handler,
+		std::size_t batchSize = 4096);
+
+private:
+	inline std::string_view nextLine();
+	inline bool nextCsvRecord(std::vector<std::string_view> & fields);
+	inline bool findCsvHeader();
+
+	metaf::MappedFile file;
+	Format archiveFormat = Format::LINES;
+	std::size_t position = 0;
+	std::size_t dataBegin = 0;
+	std::size_t rawTextIndex = 0;
+	std::optional<std::size_t> stationIdIndex;
+	// Quoted fields with doubled quotes are the only ones which are copied
+	std::deque<std::string> unescaped;
+};
+
+bool ArchiveReader::open(const std::string & path, std::string & error) {
+	if (!file.open(path, error, metaf::MappedFile::Access::SEQUENTIAL)) return false;
+	position = 0;
+	unescaped.clear();
+	archiveFormat = findCsvHeader() ? Format::CSV : Format::LINES;
+	dataBegin = (archiveFormat == Format::CSV) ? position : 0;
+	return true;
+}
+
+template <typename Handler>
+std::size_t ArchiveReader::forEach(Handler && handler) {
+	position = dataBegin;
+	std::size_t count = 0;
+	if (archiveFormat == Format::LINES) {
+		while (position < file.size()) {
+			const auto line = nextLine();
+			if (line.empty()) continue;
+			handler(std::string_view(), line);
+			count++;
+		}
+		return count;
+	}
+	std::vector<std::string_view> fields;
+	while (nextCsvRecord(fields)) {
+		if (fields.size() <= rawTextIndex) continue;
+		std::string_view stationId;
+		if (stationIdIndex.has_value() && *stationIdIndex < fields.size())
+			stationId = fields[*stationIdIndex];
+		handler(stationId, fields[rawTextIndex]);
+		count++;
+	}
+	return count;
+}
+
+std::size_t ArchiveReader::parse(metaf::BulkParser & parser,
+	const ReportHandler & handler,
+	std::size_t batchSize)
+{
+	if (!batchSize) batchSize = 1;
+	std::vector<std::string_view> batch;
+	batch.reserve(batchSize);
+	std::size_t batchEnd = 0;
+	const auto parseBatch = [&] {
+		const auto results = parser.parse(batch);
+		for (std::size_t i = 0; i < batch.size(); i++) handler(batch[i], results[i]);
+		batch.clear();
+		unescaped.clear();
+		// Pages of already parsed reports are not needed anymore
+		file.release(batchEnd);
+	};
+	const auto count = forEach([&](std::string_view, std::string_view report) {
+		batch.push_back(report);
+		if (batch.size() < batchSize) return;
+		batchEnd = position;
+		parseBatch();
+	});
+	batchEnd = position;
+	if (!batch.empty()) parseBatch();
+	return count;
+}
+
+std::string_view ArchiveReader::nextLine() {
+	const auto begin = file.data() + position;
+	const auto left = file.size() - position;
+	const auto newline = static_cast<const char *>(std::memchr(begin, '\n', left));
+	auto length = newline ? static_cast<std::size_t>(newline - begin) : left;
+	position += newline ? length + 1 : length;
+	if (length && begin[length - 1] == '\r') length--;
+	return std::string_view(begin, length);
+}
+
+bool ArchiveReader::findCsvHeader() {
+	// Header follows a few preamble lines (see CsvParser), it is never far
+	// from the beginning of file
+	static const std::size_t maxPreambleLines = 64;
+	for (std::size_t i = 0; i < maxPreambleLines && position < file.size(); i++) {
+		const auto line = nextLine();
+		if (line.substr(0, 9) != "raw_text,") continue;
+		std::size_t column = 0;
+		std::size_t begin = 0;
+		while (true) {
+			const auto end = line.find(',', begin);
+			const auto name = line.substr(begin, end - begin);
+			if (name == "raw_text") rawTextIndex = column;
+			if (name == "station_id") stationIdIndex = column;
+			if (end == std::string_view::npos) break;
+			begin = end + 1;
+			column++;
+		}
+		return true;
+	}
+	position = 0;
+	return false;
+}
+
+bool ArchiveReader::nextCsvRecord(std::vector<std::string_view> & fields) {
+	fields.clear();
+	const char * const data = file.data();
+	const std::size_t size = file.size();
+	// Blank lines are skipped
+	while (position < size && (data[position] == '\n' || data[position] == '\r'))
+		position++;
+	if (position >= size) return false;
+	while (true) {
+		if (position < size && data[position] == '"') {
+			// Quoted field may contain delimiters, line breaks and doubled quotes
+			const auto begin = ++position;
+			auto end = size;
+			bool hasDoubledQuotes = false;
+			while (position < size) {
+				const auto quote = static_cast<const char *>(
+					std::memchr(data + position, '"', size - position));
+				if (!quote) { position = size; break; }
+				position = quote - data + 1;
+				if (position < size && data[position] == '"') {
+					hasDoubledQuotes = true;
+					position++;
+					continue;
+				}
+				end = position - 1;
+				break;
+			}
+			std::string_view field(data + begin, end - begin);
+			if (hasDoubledQuotes) {
+				std::string s;
+				for (std::size_t i = 0; i < field.size(); i++) {
+					s.push_back(field[i]);
+					if (field[i] == '"') i++;
+				}
+				unescaped.push_back(std::move(s));
+				field = unescaped.back();
+			}
+			fields.push_back(field);
+			// Anything between closing quote and delimiter is ignored
+			while (position < size && data[position] != ',' && data[position] != '\n')
+				position++;
+		} else {
+			const auto begin = position;
+			while (position < size && data[position] != ',' && data[position] != '\n')
+				position++;
+			auto end = position;
+			if (end > begin && data[end - 1] == '\r') end--;
+			fields.emplace_back(data + begin, end - begin);
+		}
+		if (position >= size) break;
+		if (data[position++] == '\n') break;
+	}
+	return true;
+}
+
+} //namespace awc
+
+#endif //#ifndef AWC_ARCHIVE_HPP
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Route briefing: METAR and TAF reports of flight path query grouped by station            //
+//                                                                                            //
+//   Route is any list of waypoint stations (departure, en-route alternates, destination);    //
+//   briefing lists the waypoints in route order followed by other stations found within      //
+//   the flight path corridor, each with its METARs and TAFs latest first.                    //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AWC_BRIEFING_HPP
+#define AWC_BRIEFING_HPP
+
+#include "awc_reports.hpp"
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace awc {
+
+// Splits route text such as "UKOO UKKK,UKBB" into upper case station IDs;
+// stations may be separated by spaces, commas or semicolons
+inline std::vector<std::string> parseWaypoints(std::string_view route);
+
+// Reports of one station; pointers refer to reports of the queries
+struct StationBriefing {
+	std::string stationId;
+	// Position in the route, or none if station is not a waypoint
+	std::optional<std::size_t> waypoint;
+	std::vector<const StationReport *> metars;
+	std::vector<const StationReport *> tafs;
+
+	const StationReport * latestMetar() const {
+		return metars.empty() ? nullptr : metars.front();
+	}
+	const StationReport * latestTaf() const {
+		return tafs.empty() ? nullptr : tafs.front();
+	}
+};
+
+class RouteBriefing {
+public:
+	// Queries must outlive the briefing and must not be requested again
+	// while the briefing is in use
+	inline RouteBriefing(const std::vector<std::string> & waypoints,
+		const ReportQuery & metars,
+		const ReportQuery & tafs);
+
+	// Waypoints first (also those without reports, a station listed twice
+	// in the route appears once), then other corridor stations by ID
+	const std::vector<StationBriefing> & stations() const { return briefings; }
+	inline const StationBriefing * find(std::string_view stationId) const;
+	std::size_t waypointCount() const { return waypoints; }
+
+private:
+	inline StationBriefing & station(const std::string & stationId);
+
+	std::vector<StationBriefing> briefings;
+	std::unordered_map<std::string, std::size_t> index;
+	std::size_t waypoints = 0;
+};
+
+std::vector<std::string> parseWaypoints(std::string_view route) {
+	std::vector<std::string> result;
+	std::string waypoint;
+	for (std::size_t i = 0; i <= route.size(); i++) {
+		const char c = (i < route.size()) ? route[i] : ' ';
+		if (c == ' ' || c == '\t' || c == ',' || c == ';') {
+			if (!waypoint.empty()) result.push_back(std::move(waypoint));
+			waypoint.clear();
+			continue;
+		}
+		waypoint.push_back(static_cast<char>(
+			std::toupper(static_cast<unsigned char>(c))));
+	}
+	return result;
+}
+
+RouteBriefing::RouteBriefing(const std::vector<std::string> & route,
+	const ReportQuery & metars,
+	const ReportQuery & tafs)
+{
+	for (const auto & waypoint : route) {
+		if (index.count(waypoint)) continue;
+		station(waypoint).waypoint = waypoints++;
+	}
+
+	// Stations within corridor which are not waypoints, ordered by ID
+	std::vector<std::string> others;
+	for (const auto * query : { &metars, &tafs }) {
+		for (const auto & entry : query->stations())
+			if (!index.count(entry.first)) others.push_back(entry.first);
+	}
+	std::sort(others.begin(), others.end());
+	others.erase(std::unique(others.begin(), others.end()), others.end());
+	for (const auto & stationId : others) station(stationId);
+
+	for (auto & briefing : briefings) {
+		for (const auto i : metars.stationReports(briefing.stationId))
+			briefing.metars.push_back(&metars.reports()[i]);
+		for (const auto i : tafs.stationReports(briefing.stationId))
+			briefing.tafs.push_back(&tafs.reports()[i]);
+	}
+}
+
+const StationBriefing * RouteBriefing::find(std::string_view stationId) const {
+	const auto it = index.find(std::string(stationId));
+	if (it == index.end()) return nullptr;
+	return &briefings[it->second];
+}
+
+StationBriefing & RouteBriefing::station(const std::string & stationId) {
+	index.emplace(stationId, briefings.size());
+	briefings.emplace_back();
+	briefings.back().stationId = stationId;
+	return briefings.back();
+}
+
+} //namespace awc
+
+#endif //#ifndef AWC_BRIEFING_HPP
@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Incremental parser of Aviation Weather Center dataserver CSV responses                   //
+//                                                                                            //
+//   Data are pushed in chunks of any size as they are received; each record is passed to     //
+//   the handler as soon as its last byte arrives, so that reports can be decoded while the   //
+//   rest of the response is still being downloaded.                                          //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AWC_CSV_HPP
+#define AWC_CSV_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace awc {
+
+// Single CSV record; valid only within the record handler call
+class CsvRecord {
+public:
+	std::size_t size() const { return fieldEnds.size(); }
+	inline std::string_view operator[](std::size_t index) const;
+	// Field by column name from the header line; empty if no such column
+	inline std::string_view field(std::string_view column) const;
+	std::string_view rawText() const { return fieldAt(rawTextIndex); }
+	std::string_view stationId() const { return fieldAt(stationIdIndex); }
+
+private:
+	friend class CsvParser;
+	std::string_view fieldAt(std::optional<std::size_t> index) const {
+		if (!index.has_value()) return std::string_view();
+		return (*this)[*index];
+	}
+
+	std::string data;
+	std::vector<std::size_t> fieldEnds;
+	const std::vector<std::string> * columns = nullptr;
+	std::optional<std::size_t> rawTextIndex;
+	std::optional<std::size_t> stationIdIndex;
+};
+
+// Response starts with preamble lines (errors, warnings, response time,
+// data source, number of results) followed by the header line which
+// names the columns; records follow the header line. Fields may be quoted
+// as per RFC 4180, quoted fields may contain delimiters and line breaks.
+class CsvParser {
+public:
+	using RecordHandler = std::function<void(const CsvRecord &)>;
+
+	explicit CsvParser(RecordHandler handler) : onRecord(std::move(handler)) {}
+	// Records refer to column names of their parser
+	CsvParser(const CsvParser &) = delete;
+	CsvParser & operator=(const CsvParser &) = delete;
+
+	// Consumes next chunk of the response
+	inline void feed(const char * data, std::size_t size);
+	// Call when response is complete; emits the last record if the
+	// response does not end with a line break
+	inline void finish();
+	// Prepares the parser for a new response
+	inline void reset();
+
+	const std::vector<std::string> & columns() const { return columnNames; }
+	const std::vector<std::string> & errors() const { return errorLines; }
+	const std::vector<std::string> & warnings() const { return warningLines; }
+	// Number of results as reported in preamble
+	std::optional<std::size_t> reportedResults() const { return resultCount; }
+	std::size_t recordCount() const { return records; }
+
+private:
+	enum class State {
+		PREAMBLE,
+		FIELD_START,
+		UNQUOTED,
+		QUOTED,
+		QUOTE_IN_QUOTED
+	};
+	enum class PreambleSection {
+		NONE,
+		ERRORS,
+		WARNINGS
+	};
+
+	inline void preambleLine();
+	inline void endField();
+	inline void endRecord();
+	inline static bool isNumber(std::string_view s);
+
+	RecordHandler onRecord;
+	State state = State::PREAMBLE;
+	PreambleSection section = PreambleSection::NONE;
+	std::string line;
+	CsvRecord record;
+	std::vector<std::string> columnNames;
+	std::vector<std::string> errorLines;
+	std::vector<std::string> warningLines;
+	std::optional<std::size_t> resultCount;
+	std::size_t records = 0;
+};
+
+std::string_view CsvRecord::operator[](std::size_t index) const {
+	if (index >= fieldEnds.size()) return std::string_view();
+	const auto begin = index ? fieldEnds[index - 1] : 0;
+	return std::string_view(data.data() + begin, fieldEnds[index] - begin);
+}
+
+std::string_view CsvRecord::field(std::string_view column) const {
+	if (!columns) return std::string_view();
+	for (std::size_t i = 0; i < columns->size(); i++)
+		if ((*columns)[i] == column) return (*this)[i];
+	return std::string_view();
+}
+
+void CsvParser::feed(const char * data, std::size_t size) {
+	for (std::size_t i = 0; i < size; i++) {
+		const char c = data[i];
+		switch (state) {
+			case State::PREAMBLE:
+			if (c == '\n') { preambleLine(); break; }
+			if (c != '\r') line.push_back(c);
+			break;
+
+			case State::FIELD_START:
+			if (c == '"') { state = State::QUOTED; break; }
+			state = State::UNQUOTED;
+			[[fallthrough]];
+
+			case State::UNQUOTED:
+			if (c == ',') { endField(); break; }
+			if (c == '\n') { endRecord(); break; }
+			if (c != '\r') record.data.push_back(c);
+			break;
+
+			case State::QUOTED:
+			if (c == '"') { state = State::QUOTE_IN_QUOTED; break; }
+			record.data.push_back(c);
+			break;
+
+			case State::QUOTE_IN_QUOTED:
+			// Doubled quote is literal quote, otherwise quoted part ended
+			if (c == '"') {
+				record.data.push_back(c);
+				state = State::QUOTED;
+				break;
+			}
+			state = State::UNQUOTED;
+			if (c == ',') { endField(); break; }
+			if (c == '\n') { endRecord(); break; }
+			if (c != '\r') record.data.push_back(c);
+			break;
+		}
+	}
+}
+
+void CsvParser::finish() {
+	if (state == State::PREAMBLE) {
+		if (!line.empty()) preambleLine();
+		return;
+	}
+	if (state != State::FIELD_START || !record.fieldEnds.empty()) endRecord();
+}
+
+void CsvParser::reset() {
+	state = State::PREAMBLE;
+	section = PreambleSection::NONE;
+	line.clear();
+	record.data.clear();
+	record.fieldEnds.clear();
+	record.columns = nullptr;
+	record.rawTextIndex.reset();
+	record.stationIdIndex.reset();
+	columnNames.clear();
+	errorLines.clear();
+	warningLines.clear();
+	resultCount.reset();
+	records = 0;
+}
+
+void CsvParser::preambleLine() {
+	const std::string_view l(line);
+	if (l.substr(0, 9) == "raw_text,") {
+		// Header line, records follow
+		std::size_t begin = 0;
+		while (true) {
+			const auto end = l.find(',', begin);
+			columnNames.emplace_back(l.substr(begin, end - begin));
+			if (end == std::string_view::npos) break;
+			begin = end + 1;
+		}
+		record.columns = &columnNames;
+		for (std::size_t i = 0; i < columnNames.size(); i++) {
+			if (columnNames[i] == "raw_text") record.rawTextIndex = i;
+			if (columnNames[i] == "station_id") record.stationIdIndex = i;
+		}
+		state = State::FIELD_START;
+	} else if (l == "errors" || l == "No errors") {
+		section = (l == "errors") ? PreambleSection::ERRORS : PreambleSection::NONE;
+	} else if (l == "warnings" || l == "No warnings") {
+		section = (l == "warnings") ? PreambleSection::WARNINGS : PreambleSection::NONE;
+	} else if (l.size() > 3 && l.substr(l.size() - 3) == " ms" &&
+		isNumber(l.substr(0, l.size() - 3)))
+	{
+		section = PreambleSection::NONE;
+	} else if (l.substr(0, 12) == "data source=") {
+		section = PreambleSection::NONE;
+	} else if (l.size() > 8 && l.substr(l.size() - 8) == " results" &&
+		isNumber(l.substr(0, l.size() - 8)))
+	{
+		// Count which does not fit is ignored; parser is called from curl
+		// callback and must not throw
+		const auto digits = l.substr(0, l.size() - 8);
+		std::size_t count = 0;
+		const auto converted =
+			std::from_chars(digits.data(), digits.data() + digits.size(), count);
+		if (converted.ec == std::errc()) resultCount = count;
+		section = PreambleSection::NONE;
+	} else if (!l.empty()) {
+		if (section == PreambleSection::ERRORS) errorLines.push_back(line);
+		if (section == PreambleSection::WARNINGS) warningLines.push_back(line);
+	}
+	line.clear();
+}
+
+void CsvParser::endField() {
+	record.fieldEnds.push_back(record.data.size());
+	state = State::FIELD_START;
+}
+
+void CsvParser::endRecord() {
+	endField();
+	// Blank lines are skipped
+	if (record.fieldEnds.size() > 1 || !record.data.empty()) {
+		records++;
+		if (onRecord) onRecord(record);
+	}
+	record.data.clear();
+	record.fieldEnds.clear();
+}
+
+bool CsvParser::isNumber(std::string_view s) {
+	if (s.empty()) return false;
+	for (const auto c : s)
+		if (c < '0' || c > '9') return false;
+	return true;
+}
+
+} //namespace awc
+
+#endif //#ifndef AWC_CSV_HPP
@@ -0,0 +1,490 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Unattended polling of Aviation Weather Center dataserver                                 //
+//                                                                                            //
+//   Jobs (routes and station lists) are read from configuration file and refreshed with      //
+//   their own intervals; random jitter spreads the requests in time. Refreshes are timed     //
+//   by hashed timer wheel. Latest reports of every station are kept in the state table.      //
+//   All received reports may also be stored to the history of each station.                  //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AWC_DAEMON_HPP
+#define AWC_DAEMON_HPP
+
+#include "awc_history.hpp"
+#include "awc_reports.hpp"
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace awc {
+
+// Configuration file is a sequence of lines, # begins a comment:
+//
+//   server <url>                  dataserver URL (default is dataserverUrl)
+//   state <file>                  write latest state table to file
+//   history <directory>           store all received reports (awc_history.hpp)
+//   cache <megabytes>             parse cache size, 0 disables the cache
+//                                 (default 64, see metaf_cache.hpp)
+//   route <ICAO> <ICAO> [...]     reports along the route (flightPath)
+//   stations <ICAO> [...]         reports of listed stations
+//
+// Route and station lines may be followed by options: radius=<miles>
+// (routes only), hours=<hours before now>, interval=<seconds> and
+// jitter=<seconds>; refresh time is interval plus or minus jitter.
+struct DaemonJob {
+	enum class Type {
+		ROUTE,
+		STATIONS
+	};
+
+	Type type = Type::STATIONS;
+	std::vector<std::string> stations;
+	unsigned int radius = 50;
+	unsigned int hoursBeforeNow = 2;
+	std::chrono::seconds interval = std::chrono::seconds(60);
+	std::chrono::seconds jitter = std::chrono::seconds(0);
+};
+
+struct DaemonConfig {
+	std::vector<DaemonJob> jobs;
+	std::string serverUrl = dataserverUrl;
+	std::string stateFile;
+	std::string historyDirectory;
+	unsigned int cacheMegabytes = 64;
+
+	// Returns empty optional and describes the problem in error if the
+	// configuration is not valid
+	inline static std::optional<DaemonConfig> load(std::istream & input,
+		std::string & error);
+
+private:
+	inline static bool isStation(const std::string & s);
+	inline static std::optional<unsigned int> number(const std::string & s);
+};
+
+// Hashed timer wheel: timer expiring in n ticks is placed into the slot
+// n ticks ahead of current one, along with the number of full turns of
+// the wheel to wait; scheduling and expiry cost does not depend on the
+// number of timers.
+class TimerWheel {
+public:
+	inline explicit TimerWheel(std::size_t slotCount = 512);
+
+	// Schedules timer to expire in given number of ticks (at least one)
+	inline void schedule(std::size_t id, std::size_t ticks);
+	// Advances the wheel by one tick, appends ids of expired timers
+	inline void tick(std::vector<std::size_t> & expired);
+	std::size_t size() const { return timerCount; }
+
+private:
+	struct Timer {
+		std::size_t id;
+		std::size_t turns;
+	};
+
+	std::vector<std::vector<Timer>> slots;
+	std::size_t current = 0;
+	std::size_t timerCount = 0;
+};
+
+struct StationState {
+	StationReport metar;
+	StationReport taf;
+	std::chrono::system_clock::time_point metarUpdated;
+	std::chrono::system_clock::time_point tafUpdated;
+};
+
+// Latest METAR and TAF of every station received by any of the queries
+class LatestStateTable {
+public:
+	// Takes the latest report of each station from the query unless the
+	// stored report is as recent (e.g. received by a job with a shorter
+	// window); returns the number of stations whose report has changed
+	inline std::size_t update(const ReportQuery & query,
+		bool isTaf,
+		std::ostream * changes = nullptr);
+
+	inline const StationState * find(std::string_view station) const;
+	const std::map<std::string, StationState, std::less<>> & stations() const {
+		return table;
+	}
+
+	// One line per report: station, report type and raw report text,
+	// separated by tabs
+	inline void write(std::ostream & output) const;
+
+private:
+	inline static void writeReport(std::ostream & output,
+		const StationReport & report,
+		const char * type);
+
+	std::map<std::string, StationState, std::less<>> table;
+};
+
+class Daemon {
+public:
+	inline explicit Daemon(DaemonConfig config);
+
+	// Polls the dataserver until stop is requested
+	inline void run();
+	// May be called from signal handler or other thread
+	static void requestStop() { stopRequested = true; }
+
+	const LatestStateTable & state() const { return table; }
+	// Reports received again by later polls are not parsed again
+	const metaf::ParseCache & parseCache() const { return cache; }
+
+private:
+	struct Job {
+		DaemonJob config;
+		std::unique_ptr<ReportQuery> metars;
+		std::unique_ptr<ReportQuery> tafs;
+	};
+
+	inline void poll(const std::vector<std::size_t> & due);
+	inline std::size_t nextRefresh(const DaemonJob & job);
+	inline bool writeState(std::string & error) const;
+
+	static const inline auto tickDuration = std::chrono::seconds(1);
+	static inline std::atomic<bool> stopRequested = false;
+
+	std::string stateFile;
+	// Shared by queries of all jobs, which often receive the same reports
+	metaf::ParseCache cache;
+	std::vector<Job> jobs;
+	TimerWheel wheel;
+	FetchEngine engine;
+	LatestStateTable table;
+	ReportHistory history;
+	bool historyEnabled = false;
+	std::mt19937 random;
+};
+
+std::optional<DaemonConfig> DaemonConfig::load(std::istream & input,
+	std::string & error)
+{
+	DaemonConfig config;
+	std::string line;
+	for (std::size_t lineNumber = 1; std::getline(input, line); lineNumber++) {
+		const auto comment = line.find('#');
+		if (comment != std::string::npos) line.erase(comment);
+		std::istringstream words(line);
+		std::string keyword;
+		if (!(words >> keyword)) continue;
+		const auto where = "line " + std::to_string(lineNumber) + ": ";
+
+		if (keyword == "server") {
+			if (!(words >> config.serverUrl)) {
+				error = where + "server URL expected";
+				return std::optional<DaemonConfig>();
+			}
+			continue;
+		}
+		if (keyword == "state") {
+			if (!(words >> config.stateFile)) {
+				error = where + "state file name expected";
+				return std::optional<DaemonConfig>();
+			}
+			continue;
+		}
+		if (keyword == "cache") {
+			std::string size;
+			words >> size;
+			const auto megabytes = number(size);
+			if (!megabytes.has_value()) {
+				error = where + "cache size in megabytes expected";
+				return std::optional<DaemonConfig>();
+			}
+			config.cacheMegabytes = *megabytes;
+			continue;
+		}
+		if (keyword == "history") {
+			if (!(words >> config.historyDirectory)) {
+				error = where + "history directory expected";
+				return std::optional<DaemonConfig>();
+			}
+			continue;
+		}
+		if (keyword != "route" && keyword != "stations") {
+			error = where + "unknown keyword " + keyword;
+			return std::optional<DaemonConfig>();
+		}
+		DaemonJob job;
+		job.type = (keyword == "route") ? DaemonJob::Type::ROUTE : DaemonJob::Type::STATIONS;
+		std::string word;
+		while (words >> word) {
+			const auto equals = word.find('=');
+			if (equals == std::string::npos) {
+				if (!isStation(word)) {
+					error = where + "invalid station " + word;
+					return std::optional<DaemonConfig>();
+				}
+				job.stations.push_back(word);
+				continue;
+			}
+			const auto option = word.substr(0, equals);
+			const auto value = number(word.substr(equals + 1));
+			if (!value.has_value()) {
+				error = where + "invalid value of " + option;
+				return std::optional<DaemonConfig>();
+			}
+			if (option == "radius" && job.type == DaemonJob::Type::ROUTE) {
+				job.radius = *value;
+			} else if (option == "hours") {
+				job.hoursBeforeNow = *value;
+			} else if (option == "interval" && *value) {
+				job.interval = std::chrono::seconds(*value);
+			} else if (option == "jitter") {
+				job.jitter = std::chrono::seconds(*value);
+			} else {
+				error = where + "invalid option " + word;
+				return std::optional<DaemonConfig>();
+			}
+		}
+		if (job.jitter >= job.interval) {
+			error = where + "jitter must be less than interval";
+			return std::optional<DaemonConfig>();
+		}
+		const std::size_t minStations = (job.type == DaemonJob::Type::ROUTE) ? 2 : 1;
+		if (job.stations.size() < minStations) {
+			error = where + "not enough stations";
+			return std::optional<DaemonConfig>();
+		}
+		config.jobs.push_back(std::move(job));
+	}
+	if (config.jobs.empty()) {
+		error = "no routes or stations to poll";
+		return std::optional<DaemonConfig>();
+	}
+	return config;
+}
+
+bool DaemonConfig::isStation(const std::string & s) {
+	if (s.length() != 4) return false;
+	for (const auto c : s)
+		if (!std::isupper(static_cast<unsigned char>(c)) &&
+			!std::isdigit(static_cast<unsigned char>(c))) return false;
+	return true;
+}
+
+std::optional<unsigned int> DaemonConfig::number(const std::string & s) {
+	if (s.empty() || s.length() > 6) return std::optional<unsigned int>();
+	unsigned int result = 0;
+	for (const auto c : s) {
+		if (!std::isdigit(static_cast<unsigned char>(c)))
+			return std::optional<unsigned int>();
+		result = result * 10 + (c - '0');
+	}
+	return result;
+}
+
+TimerWheel::TimerWheel(std::size_t slotCount) :
+	slots(slotCount ? slotCount : 1)
+{
+}
+
+void TimerWheel::schedule(std::size_t id, std::size_t ticks) {
+	if (!ticks) ticks = 1;
+	const auto slot = (current + ticks) % slots.size();
+	slots[slot].push_back(Timer{id, (ticks - 1) / slots.size()});
+	timerCount++;
+}
+
+void TimerWheel::tick(std::vector<std::size_t> & expired) {
+	current = (current + 1) % slots.size();
+	auto & timers = slots[current];
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < timers.size(); i++) {
+		if (!timers[i].turns) {
+			expired.push_back(timers[i].id);
+			timerCount--;
+			continue;
+		}
+		timers[i].turns--;
+		timers[kept++] = timers[i];
+	}
+	timers.resize(kept);
+}
+
+std::size_t LatestStateTable::update(const ReportQuery & query,
+	bool isTaf,
+	std::ostream * changes)
+{
+	std::size_t changed = 0;
+	const auto now = std::chrono::system_clock::now();
+	for (const auto & station : query.stations()) {
+		const auto & report = query.reports()[station.second.front()];
+		auto & state = table[report.stationId];
+		auto & stored = isTaf ? state.taf : state.metar;
+		if (stored.rawText == report.rawText) continue;
+		// Report of unknown time only fills in a missing report
+		const bool isLater = report.time.has_value() ?
+			(!stored.time.has_value() || *report.time > *stored.time) :
+			stored.rawText.empty();
+		if (!isLater) continue;
+		stored = report;
+		(isTaf ? state.tafUpdated : state.metarUpdated) = now;
+		if (changes) writeReport(*changes, stored, isTaf ? "TAF" : "METAR");
+		changed++;
+	}
+	return changed;
+}
+
+const StationState * LatestStateTable::find(std::string_view station) const {
+	const auto it = table.find(station);
+	if (it == table.end()) return nullptr;
+	return &it->second;
+}
+
+void LatestStateTable::write(std::ostream & output) const {
+	for (const auto & station : table) {
+		writeReport(output, station.second.metar, "METAR");
+		writeReport(output, station.second.taf, "TAF");
+	}
+}
+
+void LatestStateTable::writeReport(std::ostream & output,
+	const StationReport & report,
+	const char * type)
+{
+	if (report.rawText.empty()) return;
+	output << report.stationId << '\t' << type << '\t';
+	// Keep one report per line
+	for (const auto c : report.rawText)
+		output << ((c == '\n' || c == '\r' || c == '\t') ? ' ' : c);
+	output << '\n';
+}
+
+Daemon::Daemon(DaemonConfig config) :
+	stateFile(std::move(config.stateFile)),
+	cache(std::size_t(config.cacheMegabytes) * 1024 * 1024),
+	random(std::random_device()())
+{
+	if (!config.historyDirectory.empty()) {
+		std::string error;
+		historyEnabled = history.open(config.historyDirectory, error);
+		if (!historyEnabled) std::cerr << error << std::endl;
+	}
+	const auto sharedCache = cache.memoryLimit() ? &cache : nullptr;
+	for (auto & jobConfig : config.jobs) {
+		Job job;
+		if (jobConfig.type == DaemonJob::Type::ROUTE) {
+			job.metars = std::make_unique<ReportQuery>(flightPathUrl("metars",
+				jobConfig.stations, jobConfig.radius, jobConfig.hoursBeforeNow,
+				config.serverUrl), nullptr, sharedCache);
+			job.tafs = std::make_unique<ReportQuery>(flightPathUrl("tafs",
+				jobConfig.stations, jobConfig.radius, jobConfig.hoursBeforeNow,
+				config.serverUrl), nullptr, sharedCache);
+		} else {
+			job.metars = std::make_unique<ReportQuery>(stationsUrl("metars",
+				jobConfig.stations, jobConfig.hoursBeforeNow, config.serverUrl),
+				nullptr, sharedCache);
+			job.tafs = std::make_unique<ReportQuery>(stationsUrl("tafs",
+				jobConfig.stations, jobConfig.hoursBeforeNow, config.serverUrl),
+				nullptr, sharedCache);
+		}
+		job.config = std::move(jobConfig);
+		jobs.push_back(std::move(job));
+	}
+}
+
+void Daemon::run() {
+	// First refresh of every job is spread over its jitter interval
+	for (std::size_t i = 0; i < jobs.size(); i++) {
+		const auto jitter = static_cast<std::size_t>(jobs[i].config.jitter / tickDuration);
+		wheel.schedule(i, 1 + std::uniform_int_distribution<std::size_t>(0, jitter)(random));
+	}
+	auto nextTick = std::chrono::steady_clock::now() + tickDuration;
+	std::vector<std::size_t> due;
+	while (!stopRequested) {
+		std::this_thread::sleep_until(nextTick);
+		// Ticks missed while fetching are caught up, so that refresh times
+		// do not drift by the duration of the fetch
+		due.clear();
+		while (nextTick <= std::chrono::steady_clock::now()) {
+			wheel.tick(due);
+			nextTick += tickDuration;
+		}
+		if (!due.empty()) poll(due);
+	}
+}
+
+void Daemon::poll(const std::vector<std::size_t> & due) {
+	std::size_t changed = 0;
+	auto onComplete = [&](const ReportQuery & query, const FetchResult & result, bool isTaf) {
+		if (!result.isOk()) {
+			std::cerr << query.url() << ": request failed: "
+				<< (result.code != CURLE_OK ? result.error : "HTTP status " +
+					std::to_string(result.httpStatus)) << std::endl;
+			return;
+		}
+		for (const auto & error : query.errors())
+			std::cerr << query.url() << ": dataserver error: " << error << std::endl;
+		if (!query.isModified()) return;
+		changed += table.update(query, isTaf, &std::cout);
+		if (historyEnabled) history.append(query, isTaf);
+	};
+	// All due jobs are fetched at once
+	for (const auto index : due) {
+		auto & job = jobs[index];
+		engine.add(job.metars->request([&](const ReportQuery & query, const FetchResult & result) {
+			onComplete(query, result, false);
+		}));
+		engine.add(job.tafs->request([&](const ReportQuery & query, const FetchResult & result) {
+			onComplete(query, result, true);
+		}));
+	}
+	engine.run();
+	std::cout.flush();
+	if (std::string error; historyEnabled && !history.flush(error))
+		std::cerr << "history: " << error << std::endl;
+	for (const auto index : due) wheel.schedule(index, nextRefresh(jobs[index].config));
+	if (std::string error; changed && !stateFile.empty() && !writeState(error))
+		std::cerr << "state: " << error << std::endl;
+}
+
+std::size_t Daemon::nextRefresh(const DaemonJob & job) {
+	const auto interval = static_cast<long long>(job.interval / tickDuration);
+	const auto jitter = static_cast<long long>(job.jitter / tickDuration);
+	const auto ticks = interval +
+		std::uniform_int_distribution<long long>(-jitter, jitter)(random);
+	return static_cast<std::size_t>(ticks > 0 ? ticks : 1);
+}
+
+bool Daemon::writeState(std::string & error) const {
+	// Readers never see partially written state file
+	const auto tempFile = stateFile + ".tmp";
+	{
+		std::ofstream output(tempFile);
+		if (output) table.write(output);
+		if (output) output.close();
+		if (!output) {
+			std::remove(tempFile.c_str());
+			error = "cannot write " + tempFile;
+			return false;
+		}
+	}
+	if (!std::rename(tempFile.c_str(), stateFile.c_str())) return true;
+	// Windows does not rename over existing file
+	std::remove(stateFile.c_str());
+	if (!std::rename(tempFile.c_str(), stateFile.c_str())) return true;
+	error = "cannot rename " + tempFile + " to " + stateFile;
+	return false;
+}
+
+} //namespace awc
+
+#endif //#ifndef AWC_DAEMON_HPP
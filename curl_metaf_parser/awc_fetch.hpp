@@ -0,0 +1,429 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Concurrent fetch engine for Aviation Weather Center dataserver requests                  //
+//                                                                                            //
+//   All queued requests (any data sources, any number of routes) are performed at once       //
+//   via libcurl multi interface; completion handler of each request is called as soon as     //
+//   this request finishes. Total latency is that of the slowest request.                     //
+//   Easy handles are pooled and share DNS cache, TLS sessions and connections; responses     //
+//   are transferred compressed and decoded in streaming fashion.                             //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AWC_FETCH_HPP
+#define AWC_FETCH_HPP
+
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "curl/curl.h"
+
+namespace awc {
+
+struct FetchResult {
+	CURLcode code = CURLE_OK;
+	long httpStatus = 0;
+	double seconds = 0.0;	// Total time of this transfer
+	double connectSeconds = 0.0;	// Time spent on DNS, TCP and TLS handshakes
+	bool isReusedConnection = false;
+	// Body size as transferred (possibly compressed) and after decoding
+	std::size_t wireBytes = 0;
+	std::size_t decodedBytes = 0;
+	std::string error;		// Detailed curl error message, if any
+	// Validators of the response, for conditional requests
+	std::string etag;
+	std::string lastModified;
+
+	bool isOk() const { return (code == CURLE_OK && httpStatus < 400); }
+	bool isNotModified() const { return (code == CURLE_OK && httpStatus == 304); }
+};
+
+struct FetchRequest {
+	std::string url;
+	// Additional request headers, e.g. "If-None-Match: <etag>"
+	std::vector<std::string> headers;
+	// Receive chunks of decoded response body and headers as they arrive
+	std::function<void(const char *, std::size_t)> onBody;
+	std::function<void(const char *, std::size_t)> onHeader;
+	// Called once when the request has finished, successfully or not
+	std::function<void(const FetchRequest &, const FetchResult &)> onComplete;
+};
+
+// Engine is meant to be long-lived: easy handles are pooled and reused,
+// and all of them share DNS cache, TLS sessions and connection cache, so
+// that repeated polls do not pay for name resolution and handshakes again.
+class FetchEngine {
+public:
+	// Pool size is the maximum number of easy handles, and therefore of
+	// simultaneous transfers; further requests wait for a free handle.
+	// Handles and connections idle for longer than idleTimeout are closed.
+	inline explicit FetchEngine(std::size_t poolSize = 32,
+		std::chrono::seconds idleTimeout = std::chrono::minutes(5));
+	inline ~FetchEngine();
+	FetchEngine(const FetchEngine &) = delete;
+	FetchEngine & operator=(const FetchEngine &) = delete;
+
+	// Queues request; transfers start when run() is called. Completion
+	// handlers may queue further requests, these are run by the same run().
+	inline void add(FetchRequest request);
+
+	// Performs all queued requests concurrently; returns when all are done
+	inline void run();
+
+	std::size_t handleCount() const { return handles; }
+	std::size_t idleHandleCount() const { return idle.size(); }
+
+private:
+	struct Transfer {
+		FetchRequest request;
+		CURL * handle = nullptr;
+		curl_slist * headerList = nullptr;
+		std::size_t decodedBytes = 0;
+		std::string etag;
+		std::string lastModified;
+		char errorBuffer[CURL_ERROR_SIZE] = {};
+	};
+	struct IdleHandle {
+		CURL * handle;
+		std::chrono::steady_clock::time_point lastUsed;
+	};
+
+	inline CURL * acquireHandle();
+	inline void releaseHandle(CURL * handle);
+	inline void evictIdleHandles();
+	inline bool canStart() const;
+	inline void startQueued();
+	// Returns false if no handle is available; request which cannot be
+	// added to multi handle is completed with CURLE_FAILED_INIT
+	inline bool start(std::unique_ptr<Transfer> & transfer);
+	inline void finish(CURL * handle, CURLcode code);
+	inline static void complete(const Transfer & transfer, FetchResult & result);
+	inline static bool headerValue(std::string_view line,
+		std::string_view name,
+		std::string & value);
+	inline static std::size_t writeBody(char * ptr,
+		std::size_t size,
+		std::size_t nmemb,
+		void * userdata);
+	inline static std::size_t writeHeader(char * ptr,
+		std::size_t size,
+		std::size_t nmemb,
+		void * userdata);
+
+	// Maximum time to wait for socket activity before polling transfers again
+	static const inline int pollTimeoutMs = 1000;
+
+	const std::size_t poolSize;
+	const std::chrono::seconds idleTimeout;
+	CURLM * multi = nullptr;
+	CURLSH * share = nullptr;
+	std::size_t handles = 0;	// Handles in use and idle ones
+	std::vector<IdleHandle> idle;
+	std::deque<std::unique_ptr<Transfer>> queued;
+	std::vector<std::unique_ptr<Transfer>> active;
+};
+
+FetchEngine::FetchEngine(std::size_t poolSize, std::chrono::seconds idleTimeout) :
+	poolSize(poolSize ? poolSize : 1), idleTimeout(idleTimeout)
+{
+	curl_global_init(CURL_GLOBAL_DEFAULT);
+	multi = curl_multi_init();
+	if (multi) {
+		curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, static_cast<long>(this->poolSize));
+	}
+	// Handles are used from one thread only, so no lock callbacks are needed
+	share = curl_share_init();
+	if (share) {
+		curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+		curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+		curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+	}
+}
+
+FetchEngine::~FetchEngine() {
+	for (auto & transfer : active) {
+		curl_multi_remove_handle(multi, transfer->handle);
+		curl_easy_cleanup(transfer->handle);
+		curl_slist_free_all(transfer->headerList);
+	}
+	for (auto & handle : idle) curl_easy_cleanup(handle.handle);
+	if (multi) curl_multi_cleanup(multi);
+	if (share) curl_share_cleanup(share);
+	curl_global_cleanup();
+}
+
+void FetchEngine::add(FetchRequest request) {
+	auto transfer = std::make_unique<Transfer>();
+	transfer->request = std::move(request);
+	queued.push_back(std::move(transfer));
+}
+
+void FetchEngine::run() {
+	evictIdleHandles();
+	while (true) {
+		// Requests queued by completion handlers join the running ones
+		startQueued();
+		if (active.empty()) break;
+
+		int running = 0;
+		if (curl_multi_perform(multi, &running) != CURLM_OK) {
+			while (!active.empty()) finish(active.back()->handle, CURLE_FAILED_INIT);
+			continue;
+		}
+		int messages = 0;
+		while (CURLMsg * msg = curl_multi_info_read(multi, &messages)) {
+			if (msg->msg == CURLMSG_DONE) finish(msg->easy_handle, msg->data.result);
+		}
+		if (running && !canStart())
+			curl_multi_poll(multi, nullptr, 0, pollTimeoutMs, nullptr);
+	}
+}
+
+CURL * FetchEngine::acquireHandle() {
+	if (!idle.empty()) {
+		// Most recently used handle is the most likely to have a live connection
+		CURL * handle = idle.back().handle;
+		idle.pop_back();
+		curl_easy_reset(handle);
+		return handle;
+	}
+	if (handles >= poolSize) return nullptr;
+	CURL * handle = curl_easy_init();
+	if (handle) handles++;
+	return handle;
+}
+
+void FetchEngine::releaseHandle(CURL * handle) {
+	idle.push_back(IdleHandle{handle, std::chrono::steady_clock::now()});
+}
+
+void FetchEngine::evictIdleHandles() {
+	const auto now = std::chrono::steady_clock::now();
+	auto it = idle.begin();
+	while (it != idle.end()) {
+		if (now - it->lastUsed < idleTimeout) { it++; continue; }
+		curl_easy_cleanup(it->handle);
+		handles--;
+		it = idle.erase(it);
+	}
+}
+
+bool FetchEngine::canStart() const {
+	return (!queued.empty() && (!idle.empty() || handles < poolSize));
+}
+
+void FetchEngine::startQueued() {
+	while (!queued.empty()) {
+		if (!start(queued.front())) {
+			// Pool exhausted; request waits for a transfer to finish
+			if (!active.empty()) return;
+			FetchResult result;
+			result.code = CURLE_FAILED_INIT;
+			complete(*queued.front(), result);
+		}
+		queued.pop_front();
+	}
+}
+
+bool FetchEngine::start(std::unique_ptr<Transfer> & transfer) {
+	CURL * handle = multi ? acquireHandle() : nullptr;
+	if (!handle) return false;
+	transfer->handle = handle;
+	curl_easy_setopt(handle, CURLOPT_URL, transfer->request.url.c_str());
+	curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, 0L);
+	if (share) curl_easy_setopt(handle, CURLOPT_SHARE, share);
+	curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+	curl_easy_setopt(handle, CURLOPT_MAXAGE_CONN, static_cast<long>(idleTimeout.count()));
+	// CSV responses compress very well; empty string offers all encodings
+	// supported by libcurl build, body is decoded on the fly chunk by chunk
+	curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");
+	curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, writeBody);
+	curl_easy_setopt(handle, CURLOPT_WRITEDATA, transfer.get());
+	curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, writeHeader);
+	curl_easy_setopt(handle, CURLOPT_HEADERDATA, transfer.get());
+	curl_easy_setopt(handle, CURLOPT_ERRORBUFFER, transfer->errorBuffer);
+	curl_easy_setopt(handle, CURLOPT_PRIVATE, transfer.get());
+	for (const auto & header : transfer->request.headers)
+		transfer->headerList = curl_slist_append(transfer->headerList, header.c_str());
+	if (transfer->headerList)
+		curl_easy_setopt(handle, CURLOPT_HTTPHEADER, transfer->headerList);
+	if (const auto code = curl_multi_add_handle(multi, handle); code != CURLM_OK) {
+		releaseHandle(handle);
+		transfer->handle = nullptr;
+		curl_slist_free_all(transfer->headerList);
+		transfer->headerList = nullptr;
+		// Retrying would only spin while other transfers are running
+		FetchResult result;
+		result.code = CURLE_FAILED_INIT;
+		result.error = curl_multi_strerror(code);
+		complete(*transfer, result);
+		return true;
+	}
+	active.push_back(std::move(transfer));
+	return true;
+}
+
+void FetchEngine::finish(CURL * handle, CURLcode code) {
+	std::unique_ptr<Transfer> transfer;
+	for (auto it = active.begin(); it != active.end(); it++) {
+		if ((*it)->handle != handle) continue;
+		transfer = std::move(*it);
+		active.erase(it);
+		break;
+	}
+	if (!transfer) return;
+
+	FetchResult result;
+	result.code = code;
+	curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &result.httpStatus);
+	curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME, &result.seconds);
+	curl_easy_getinfo(handle, CURLINFO_APPCONNECT_TIME, &result.connectSeconds);
+	if (result.connectSeconds == 0.0)
+		curl_easy_getinfo(handle, CURLINFO_CONNECT_TIME, &result.connectSeconds);
+	long newConnections = 0;
+	curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &newConnections);
+	result.isReusedConnection = (code == CURLE_OK && !newConnections);
+	curl_off_t wireBytes = 0;
+	curl_easy_getinfo(handle, CURLINFO_SIZE_DOWNLOAD_T, &wireBytes);
+	result.wireBytes = static_cast<std::size_t>(wireBytes);
+	result.decodedBytes = transfer->decodedBytes;
+	if (code != CURLE_OK) result.error = transfer->errorBuffer;
+	result.etag = std::move(transfer->etag);
+	result.lastModified = std::move(transfer->lastModified);
+	curl_multi_remove_handle(multi, handle);
+	releaseHandle(handle);
+	transfer->handle = nullptr;
+	curl_slist_free_all(transfer->headerList);
+	transfer->headerList = nullptr;
+	complete(*transfer, result);
+}
+
+void FetchEngine::complete(const Transfer & transfer, FetchResult & result) {
+	if (result.code != CURLE_OK && result.error.empty())
+		result.error = curl_easy_strerror(result.code);
+	if (transfer.request.onComplete) transfer.request.onComplete(transfer.request, result);
+}
+
+std::size_t FetchEngine::writeBody(char * ptr,
+	std::size_t size,
+	std::size_t nmemb,
+	void * userdata)
+{
+	auto & transfer = *static_cast<Transfer *>(userdata);
+	transfer.decodedBytes += size * nmemb;
+	if (transfer.request.onBody) transfer.request.onBody(ptr, size * nmemb);
+	return size * nmemb;
+}
+
+std::size_t FetchEngine::writeHeader(char * ptr,
+	std::size_t size,
+	std::size_t nmemb,
+	void * userdata)
+{
+	auto & transfer = *static_cast<Transfer *>(userdata);
+	const std::string_view line(ptr, size * nmemb);
+	// Status line begins headers of a new response (e.g. after redirect)
+	if (line.substr(0, 5) == "HTTP/") {
+		transfer.etag.clear();
+		transfer.lastModified.clear();
+	}
+	headerValue(line, "etag", transfer.etag);
+	headerValue(line, "last-modified", transfer.lastModified);
+	if (transfer.request.onHeader) transfer.request.onHeader(ptr, size * nmemb);
+	return size * nmemb;
+}
+
+bool FetchEngine::headerValue(std::string_view line,
+	std::string_view name,
+	std::string & value)
+{
+	// Header names are case-insensitive
+	if (line.size() <= name.size() || line[name.size()] != ':') return false;
+	for (std::size_t i = 0; i < name.size(); i++) {
+		if (std::tolower(static_cast<unsigned char>(line[i])) != name[i]) return false;
+	}
+	line.remove_prefix(name.size() + 1);
+	while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+		line.remove_prefix(1);
+	while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back())))
+		line.remove_suffix(1);
+	value = std::string(line);
+	return true;
+}
+
+// Optional side output of received data to disk: chunks are copied into
+// a queue and written by a background thread, so that receiving and
+// parsing are never delayed by file I/O.
+class AsyncFileWriter {
+public:
+	inline explicit AsyncFileWriter(const std::string & filename);
+	inline ~AsyncFileWriter();
+	AsyncFileWriter(const AsyncFileWriter &) = delete;
+	AsyncFileWriter & operator=(const AsyncFileWriter &) = delete;
+
+	bool isOpen() const { return (file != nullptr); }
+	inline void write(const char * data, std::size_t size);
+
+private:
+	inline void writerLoop();
+
+	FILE * file = nullptr;
+	std::mutex mutex;
+	std::condition_variable dataQueued;
+	std::vector<std::string> queue;
+	bool stopping = false;
+	std::thread thread;
+};
+
+AsyncFileWriter::AsyncFileWriter(const std::string & filename) {
+	file = fopen(filename.c_str(), "w");
+	if (file) thread = std::thread(&AsyncFileWriter::writerLoop, this);
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+	if (!file) return;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	dataQueued.notify_one();
+	thread.join();
+	fclose(file);
+}
+
+void AsyncFileWriter::write(const char * data, std::size_t size) {
+	if (!file || !size) return;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.emplace_back(data, size);
+	}
+	dataQueued.notify_one();
+}
+
+void AsyncFileWriter::writerLoop() {
+	std::vector<std::string> chunks;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			dataQueued.wait(lock, [this]{ return (stopping || !queue.empty()); });
+			if (queue.empty()) return;
+			chunks.swap(queue);
+		}
+		for (const auto & chunk : chunks) fwrite(chunk.data(), 1, chunk.size(), file);
+		chunks.clear();
+	}
+}
+
+} //namespace awc
+
+#endif //#ifndef AWC_FETCH_HPP
@@ -0,0 +1,668 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Append-only history of received reports, partitioned by station                          //
+//                                                                                            //
+//   Each station has its own directory with an append log and sorted segments. Appended      //
+//   reports go to the log; when the log grows over the limit it is compacted into a new      //
+//   segment sorted by report time, and small segments are merged into larger ones. Every     //
+//   segment ends with a sparse index of report times, so time range lookups are binary       //
+//   searches. Reports received again by later polls are detected and are not stored twice.   //
+//                                                                                            //
+//   Record (log and segment):  report time (int64, seconds since Unix epoch), raw text       //
+//                              length (uint32), type (uint8, 0 = METAR, 1 = TAF), 3 bytes    //
+//                              reserved, raw text                                            //
+//   Segment:                   records, index entries (time and offset of every              //
+//                              indexInterval-th record), trailer                             //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AWC_HISTORY_HPP
+#define AWC_HISTORY_HPP
+
+#include "METAF.hpp"
+#include "awc_reports.hpp"
+#include "metaf_mmap.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace awc {
+
+struct HistoryReport {
+	std::int64_t time = 0; // seconds since Unix epoch
+	bool isTaf = false;
+	std::string rawText;
+};
+
+struct HistoryOptions {
+	// Station log is compacted when it would grow over this size
+	std::size_t logLimit = 64 * 1024;
+	// Reports this much older than the latest report of the station are
+	// not checked for duplicates anymore
+	std::int64_t duplicateWindow = 3 * 24 * 3600;
+};
+
+class ReportHistory {
+public:
+	ReportHistory() = default;
+	~ReportHistory() { std::string error; flush(error); }
+	ReportHistory(const ReportHistory &) = delete;
+	ReportHistory & operator=(const ReportHistory &) = delete;
+
+	// Opens history in directory, which is created if it does not exist
+	inline bool open(const std::string & directory,
+		std::string & error,
+		HistoryOptions options = HistoryOptions());
+
+	// Returns false if the report is already stored, station ID is not
+	// valid (letters and digits only) or station directory cannot be
+	// created; reports are written by flush(), which also returns errors
+	// of creating and loading stations.
+	// Duplicates are detected within duplicateWindow of the latest report
+	// of the station; older duplicates are removed by compaction.
+	inline bool append(std::string_view stationId,
+		std::int64_t time,
+		bool isTaf,
+		std::string_view rawText);
+	// Appends all reports of the query which have valid report time;
+	// returns the number of reports which were not already stored
+	inline std::size_t append(const ReportQuery & query,
+		bool isTaf,
+		std::chrono::system_clock::time_point received =
+			std::chrono::system_clock::now());
+	// Writes appended reports to station logs, compacting the logs which
+	// grow over the limit. Damaged segments found while loading stations
+	// are renamed to *.seg.bad and reported here.
+	inline bool flush(std::string & error);
+	// Compacts logs of all stations into segments
+	inline bool compact(std::string & error);
+
+	// Reports of the station with from <= time < until, ordered by time;
+	// includes appended reports which are not flushed yet
+	inline std::vector<HistoryReport> query(std::string_view stationId,
+		std::int64_t from,
+		std::int64_t until = std::numeric_limits<std::int64_t>::max());
+	std::vector<HistoryReport> lastHours(std::string_view stationId,
+		unsigned int hours,
+		std::chrono::system_clock::time_point now = std::chrono::system_clock::now())
+	{
+		return query(stationId, seconds(now) - std::int64_t(hours) * 3600);
+	}
+
+	// Number of reports appended and not stored as duplicates
+	std::size_t appendedCount() const { return appended; }
+	std::size_t duplicateCount() const { return duplicates; }
+
+	static const inline std::size_t indexInterval = 64;
+
+private:
+	struct RecordHeader {
+		std::int64_t time;
+		std::uint32_t length;
+		std::uint8_t type;
+		std::uint8_t reserved[3];
+	};
+	struct IndexEntry {
+		std::int64_t time;
+		std::uint64_t offset;
+	};
+	struct SegmentTrailer {
+		char magic[8];
+		std::uint32_t format;
+		std::uint32_t byteOrderMark;
+		std::uint64_t recordCount;
+		std::uint64_t indexCount;
+		std::int64_t first;
+		std::int64_t last;
+	};
+	struct Segment {
+		std::uint64_t sequence;
+		std::int64_t first;
+		std::int64_t last;
+		std::uint64_t size;
+	};
+	struct LogEntry {
+		std::int64_t time;
+		std::size_t offset; // offset in log file, followed by pending data
+	};
+	struct Station {
+		std::filesystem::path directory;
+		std::vector<Segment> segments; // by sequence number
+		std::vector<LogEntry> log;     // by time
+		std::size_t logSize = 0;       // bytes written to log file
+		std::string pending;           // records not written yet
+		std::int64_t latest = std::numeric_limits<std::int64_t>::min();
+		// Hashes of recent reports to their times
+		std::unordered_map<std::uint64_t, std::int64_t> recent;
+		std::size_t recentPruned = 0;
+		bool dirty = false;
+	};
+
+	inline static std::int64_t seconds(std::chrono::system_clock::time_point t);
+	inline static bool isStationId(std::string_view stationId);
+	inline static std::uint64_t key(std::int64_t time, bool isTaf, std::string_view rawText);
+	inline static void putRecord(std::string & output,
+		std::int64_t time,
+		bool isTaf,
+		std::string_view rawText);
+	// Reads record at offset; returns false if it is incomplete
+	inline static bool getRecord(std::string_view data,
+		std::size_t offset,
+		RecordHeader & header,
+		std::string_view & rawText);
+	inline static std::optional<SegmentTrailer> trailer(std::string_view segment);
+	inline static std::filesystem::path segmentPath(const Station & station,
+		std::uint64_t sequence);
+	inline static bool readFile(const std::filesystem::path & path, std::string & data);
+
+	// Errors are kept in stationError
+	inline Station * station(std::string_view stationId, bool create);
+	inline void load(Station & station);
+	inline void remember(Station & station, std::int64_t time, std::uint64_t hash);
+	inline void queryStation(Station & station,
+		std::int64_t from,
+		std::int64_t until,
+		std::vector<HistoryReport> & reports);
+	// Readers return false if the file cannot be read or is damaged; reports
+	// read until then are kept
+	inline static bool readSegment(const Station & station,
+		const Segment & segment,
+		std::int64_t from,
+		std::int64_t until,
+		std::vector<HistoryReport> & reports);
+	inline static bool readLog(const Station & station,
+		std::int64_t from,
+		std::int64_t until,
+		std::vector<HistoryReport> & reports);
+	// Sorts reports from first by time and removes duplicates
+	inline static void sortReports(std::vector<HistoryReport> & reports, std::size_t first);
+	inline bool compact(Station & station, std::string & error);
+
+	std::filesystem::path root;
+	HistoryOptions settings;
+	std::map<std::string, Station, std::less<>> stations;
+	std::vector<Station *> dirtyStations;
+	// Last error of creating or loading a station, returned by flush()
+	std::string stationError;
+	std::size_t appended = 0;
+	std::size_t duplicates = 0;
+	bool opened = false;
+
+	static const inline char segmentMagic[8] = {'M','E','T','A','F','S','E','G'};
+	static const inline std::uint32_t segmentFormat = 1;
+	static const inline std::uint32_t byteOrderMark = 0x01020304;
+	static const inline char logName[] = "log";
+	static const inline char segmentExtension[] = ".seg";
+};
+
+bool ReportHistory::open(const std::string & directory,
+	std::string & error,
+	HistoryOptions options)
+{
+	std::error_code ec;
+	std::filesystem::create_directories(directory, ec);
+	if (!std::filesystem::is_directory(directory, ec)) {
+		error = "cannot create history directory " + directory;
+		return false;
+	}
+	root = directory;
+	settings = options;
+	stations.clear();
+	dirtyStations.clear();
+	opened = true;
+	return true;
+}
+
+bool ReportHistory::append(std::string_view stationId,
+	std::int64_t time,
+	bool isTaf,
+	std::string_view rawText)
+{
+	auto s = station(stationId, true);
+	if (!s || rawText.empty()) return false;
+	const auto hash = key(time, isTaf, rawText);
+	if (s->recent.count(hash)) {
+		duplicates++;
+		return false;
+	}
+	remember(*s, time, hash);
+
+	const LogEntry entry{time, s->logSize + s->pending.size()};
+	// Reports mostly arrive in time order, so entry is normally added to the end
+	const auto position = std::upper_bound(s->log.begin(), s->log.end(), time,
+		[](std::int64_t t, const LogEntry & e) { return t < e.time; });
+	s->log.insert(position, entry);
+	putRecord(s->pending, time, isTaf, rawText);
+	if (!s->dirty) {
+		s->dirty = true;
+		dirtyStations.push_back(s);
+	}
+	appended++;
+	return true;
+}
+
+std::size_t ReportHistory::append(const ReportQuery & query,
+	bool isTaf,
+	std::chrono::system_clock::time_point received)
+{
+	std::size_t count = 0;
+	for (const auto & report : query.reports()) {
+		const auto & metadata = report.result->reportMetadata;
+		// Time from the response is preferred to time resolved from report
+		auto time = report.time;
+		if (!time.has_value() && metadata.reportTime.has_value())
+			time = reportEpoch(*metadata.reportTime, received);
+		if (!time.has_value()) continue;
+		const auto & stationId = report.stationId.empty() ?
+			metadata.icaoLocation : report.stationId;
+		count += append(stationId, *time, isTaf, report.rawText);
+	}
+	return count;
+}
+
+bool ReportHistory::flush(std::string & error) {
+	bool ok = true;
+	for (auto s : dirtyStations) {
+		s->dirty = false;
+		if (s->pending.empty()) continue;
+		if (s->logSize + s->pending.size() > settings.logLimit) {
+			if (compact(*s, error)) continue;
+			// Reports are appended to the log until compaction succeeds
+			ok = false;
+		}
+		std::ofstream log(s->directory / logName,
+			std::ios::binary | std::ios::app);
+		if (!log.write(s->pending.data(), s->pending.size())) {
+			error = "cannot write " + (s->directory / logName).string();
+			ok = false;
+			continue;
+		}
+		s->logSize += s->pending.size();
+		s->pending.clear();
+	}
+	dirtyStations.clear();
+	if (!stationError.empty()) {
+		error = std::exchange(stationError, std::string());
+		ok = false;
+	}
+	return ok;
+}
+
+bool ReportHistory::compact(std::string & error) {
+	if (!opened) return true;
+	std::error_code ec;
+	for (const auto & entry : std::filesystem::directory_iterator(root, ec)) {
+		if (!entry.is_directory(ec)) continue;
+		station(entry.path().filename().string(), false);
+	}
+	bool ok = true;
+	if (!stationError.empty()) {
+		error = std::exchange(stationError, std::string());
+		ok = false;
+	}
+	for (auto & s : stations) {
+		if (s.second.log.empty()) continue;
+		if (!compact(s.second, error)) ok = false;
+	}
+	return ok;
+}
+
+std::vector<HistoryReport> ReportHistory::query(std::string_view stationId,
+	std::int64_t from,
+	std::int64_t until)
+{
+	std::vector<HistoryReport> reports;
+	if (const auto s = station(stationId, false); s)
+		queryStation(*s, from, until, reports);
+	return reports;
+}
+
+void ReportHistory::queryStation(Station & station,
+	std::int64_t from,
+	std::int64_t until,
+	std::vector<HistoryReport> & reports)
+{
+	const auto firstReport = reports.size();
+	for (const auto & segment : station.segments) {
+		if (segment.first >= until || segment.last < from) continue;
+		readSegment(station, segment, from, until, reports);
+	}
+	readLog(station, from, until, reports);
+	sortReports(reports, firstReport);
+}
+
+bool ReportHistory::readSegment(const Station & station,
+	const Segment & segment,
+	std::int64_t from,
+	std::int64_t until,
+	std::vector<HistoryReport> & reports)
+{
+	metaf::MappedFile file;
+	std::string error;
+	if (!file.open(segmentPath(station, segment.sequence).string(), error,
+		metaf::MappedFile::Access::RANDOM)) return false;
+	const auto data = file.view();
+	const auto t = trailer(data);
+	if (!t.has_value()) return false;
+	const auto indexSize = t->indexCount * sizeof(IndexEntry);
+	const auto recordsEnd = data.size() - sizeof(SegmentTrailer) - indexSize;
+	std::vector<IndexEntry> index(t->indexCount);
+	std::memcpy(index.data(), data.data() + recordsEnd, indexSize);
+	// Records before the last index entry with time < from are all earlier
+	// than from
+	const auto it = std::lower_bound(index.begin(), index.end(), from,
+		[](const IndexEntry & e, std::int64_t time) { return e.time < time; });
+	std::size_t offset = (it == index.begin()) ? 0 : (it - 1)->offset;
+	const auto records = data.substr(0, recordsEnd);
+	RecordHeader header;
+	std::string_view rawText;
+	while (getRecord(records, offset, header, rawText)) {
+		if (header.time >= until) return true;
+		offset += sizeof(RecordHeader) + header.length;
+		if (header.time < from) continue;
+		reports.push_back(HistoryReport{header.time, header.type != 0, std::string(rawText)});
+	}
+	// Records end exactly where the index begins unless segment is damaged
+	return (offset == records.size());
+}
+
+bool ReportHistory::readLog(const Station & station,
+	std::int64_t from,
+	std::int64_t until,
+	std::vector<HistoryReport> & reports)
+{
+	auto it = std::lower_bound(station.log.begin(), station.log.end(), from,
+		[](const LogEntry & e, std::int64_t time) { return e.time < time; });
+	if (it == station.log.end() || it->time >= until) return true;
+	// Log file is only read if it has any reports within the range
+	std::string log;
+	bool ok = true;
+	if (station.logSize) {
+		ok = readFile(station.directory / logName, log) && log.size() >= station.logSize;
+		log.resize(station.logSize);
+	}
+	log += station.pending;
+	RecordHeader header;
+	std::string_view rawText;
+	for (; it != station.log.end() && it->time < until; ++it) {
+		if (!getRecord(log, it->offset, header, rawText)) {
+			ok = false;
+			continue;
+		}
+		reports.push_back(HistoryReport{header.time, header.type != 0, std::string(rawText)});
+	}
+	return ok;
+}
+
+void ReportHistory::sortReports(std::vector<HistoryReport> & reports, std::size_t first) {
+	// Segments may overlap if reports arrived out of order, and the same
+	// report may be in log and segment if compaction was interrupted
+	const auto order = [](const HistoryReport & a, const HistoryReport & b) {
+		return std::tie(a.time, a.isTaf, a.rawText) < std::tie(b.time, b.isTaf, b.rawText);
+	};
+	const auto same = [](const HistoryReport & a, const HistoryReport & b) {
+		return (a.time == b.time && a.isTaf == b.isTaf && a.rawText == b.rawText);
+	};
+	const auto begin = reports.begin() + first;
+	if (!std::is_sorted(begin, reports.end(), order)) std::sort(begin, reports.end(), order);
+	reports.erase(std::unique(begin, reports.end(), same), reports.end());
+}
+
+bool ReportHistory::compact(Station & station, std::string & error) {
+	// Log is merged with the last segments while they are not much larger,
+	// so that the number of segments grows as logarithm of history size
+	std::uint64_t size = station.logSize + station.pending.size();
+	std::size_t merged = station.segments.size();
+	while (merged && station.segments[merged - 1].size <= 2 * size)
+		size += station.segments[--merged].size;
+	std::vector<HistoryReport> reports;
+	static const auto minTime = std::numeric_limits<std::int64_t>::min();
+	static const auto maxTime = std::numeric_limits<std::int64_t>::max();
+	// Merged segments and log are removed below, so compaction is abandoned
+	// rather than losing reports which could not be read
+	for (auto i = merged; i < station.segments.size(); i++) {
+		if (!readSegment(station, station.segments[i], minTime, maxTime, reports)) {
+			error = "cannot read " +
+				segmentPath(station, station.segments[i].sequence).string();
+			return false;
+		}
+	}
+	if (!readLog(station, minTime, maxTime, reports)) {
+		error = "cannot read " + (station.directory / logName).string();
+		return false;
+	}
+	sortReports(reports, 0);
+
+	std::string data;
+	std::vector<IndexEntry> index;
+	for (std::size_t i = 0; i < reports.size(); i++) {
+		if (!(i % indexInterval)) index.push_back(IndexEntry{reports[i].time, data.size()});
+		putRecord(data, reports[i].time, reports[i].isTaf, reports[i].rawText);
+	}
+	const auto indexBytes = index.size() * sizeof(IndexEntry);
+	data.append(reinterpret_cast<const char *>(index.data()), indexBytes);
+	SegmentTrailer t;
+	std::memcpy(t.magic, segmentMagic, sizeof(t.magic));
+	t.format = segmentFormat;
+	t.byteOrderMark = byteOrderMark;
+	t.recordCount = reports.size();
+	t.indexCount = index.size();
+	t.first = reports.empty() ? 0 : reports.front().time;
+	t.last = reports.empty() ? 0 : reports.back().time;
+	data.append(reinterpret_cast<const char *>(&t), sizeof(t));
+
+	const auto sequence = station.segments.empty() ? 1 : station.segments.back().sequence + 1;
+	const auto path = segmentPath(station, sequence);
+	std::error_code ec;
+	if (!reports.empty()) {
+		// Segment appears under its name only when completely written
+		auto tempPath = path;
+		tempPath += ".tmp";
+		{
+			std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+			if (!output.write(data.data(), data.size())) {
+				error = "cannot write " + tempPath.string();
+				return false;
+			}
+		}
+		std::filesystem::rename(tempPath, path, ec);
+		if (ec) {
+			error = "cannot rename " + tempPath.string() + ": " + ec.message();
+			return false;
+		}
+	}
+	for (auto i = merged; i < station.segments.size(); i++)
+		std::filesystem::remove(segmentPath(station, station.segments[i].sequence), ec);
+	station.segments.resize(merged);
+	if (!reports.empty())
+		station.segments.push_back(Segment{sequence, t.first, t.last, data.size()});
+	std::filesystem::remove(station.directory / logName, ec);
+	station.log.clear();
+	station.logSize = 0;
+	station.pending.clear();
+	return true;
+}
+
+ReportHistory::Station * ReportHistory::station(std::string_view stationId, bool create) {
+	if (!opened || !isStationId(stationId)) return nullptr;
+	if (const auto it = stations.find(stationId); it != stations.end()) return &it->second;
+	const auto directory = root / std::string(stationId);
+	std::error_code ec;
+	if (!std::filesystem::is_directory(directory, ec)) {
+		if (!create) return nullptr;
+		if (!std::filesystem::create_directory(directory, ec)) {
+			stationError = "cannot create " + directory.string();
+			return nullptr;
+		}
+	}
+	auto & s = stations[std::string(stationId)];
+	s.directory = directory;
+	load(s);
+	return &s;
+}
+
+void ReportHistory::load(Station & station) {
+	std::error_code ec;
+	for (const auto & entry : std::filesystem::directory_iterator(station.directory, ec)) {
+		const auto path = entry.path();
+		// Leftover of interrupted compaction
+		if (path.extension() == ".tmp") {
+			std::filesystem::remove(path, ec);
+			continue;
+		}
+		if (path.extension() != segmentExtension) continue;
+		const auto name = path.stem().string();
+		if (name.empty() || !std::all_of(name.begin(), name.end(),
+			[](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) continue;
+		metaf::MappedFile file;
+		std::string error;
+		std::optional<SegmentTrailer> t;
+		if (file.open(path.string(), error)) t = trailer(file.view());
+		if (!t.has_value()) {
+			// Damaged segment is set aside, so that the rest of the history
+			// of the station can still be queried and appended to
+			file.close();
+			auto badPath = path;
+			badPath += ".bad";
+			std::filesystem::rename(path, badPath, ec);
+			stationError = path.string() + " is not a valid history segment, " +
+				(ec ? "cannot set it aside: " + ec.message() : "moved to " + badPath.string());
+			continue;
+		}
+		station.segments.push_back(Segment{std::stoull(name), t->first, t->last, file.size()});
+		if (t->recordCount) station.latest = std::max(station.latest, t->last);
+	}
+	std::sort(station.segments.begin(), station.segments.end(),
+		[](const Segment & a, const Segment & b) { return a.sequence < b.sequence; });
+
+	const auto logPath = station.directory / logName;
+	std::string log;
+	if (readFile(logPath, log)) {
+		RecordHeader header;
+		std::string_view rawText;
+		std::size_t offset = 0;
+		while (getRecord(log, offset, header, rawText)) {
+			station.log.push_back(LogEntry{header.time, offset});
+			station.latest = std::max(station.latest, header.time);
+			offset += sizeof(RecordHeader) + header.length;
+		}
+		// Record being written when the process stopped is discarded
+		if (offset < log.size()) std::filesystem::resize_file(logPath, offset, ec);
+		station.logSize = offset;
+		std::stable_sort(station.log.begin(), station.log.end(),
+			[](const LogEntry & a, const LogEntry & b) { return a.time < b.time; });
+	}
+
+	// Recent reports are remembered to detect duplicates
+	if (station.latest != std::numeric_limits<std::int64_t>::min()) {
+		std::vector<HistoryReport> recent;
+		queryStation(station, station.latest - settings.duplicateWindow,
+			std::numeric_limits<std::int64_t>::max(), recent);
+		for (const auto & r : recent) remember(station, r.time, key(r.time, r.isTaf, r.rawText));
+	}
+}
+
+void ReportHistory::remember(Station & station, std::int64_t time, std::uint64_t hash) {
+	station.recent.emplace(hash, time);
+	station.latest = std::max(station.latest, time);
+	// Reports out of duplicate window are forgotten from time to time
+	if (station.recent.size() < 2 * station.recentPruned + 64) return;
+	const auto oldest = station.latest - settings.duplicateWindow;
+	for (auto it = station.recent.begin(); it != station.recent.end();) {
+		if (it->second < oldest) it = station.recent.erase(it);
+		else ++it;
+	}
+	station.recentPruned = station.recent.size();
+}
+
+std::int64_t ReportHistory::seconds(std::chrono::system_clock::time_point t) {
+	return std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch()).count();
+}
+
+bool ReportHistory::isStationId(std::string_view stationId) {
+	if (stationId.empty() || stationId.length() > 8) return false;
+	return std::all_of(stationId.begin(), stationId.end(),
+		[](char c) { return std::isalnum(static_cast<unsigned char>(c)); });
+}
+
+std::uint64_t ReportHistory::key(std::int64_t time, bool isTaf, std::string_view rawText) {
+	// FNV-1a
+	std::uint64_t hash = 14695981039346656037ull;
+	for (const auto c : rawText) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash ^ (static_cast<std::uint64_t>(time) * 2 + isTaf) * 0x9E3779B97F4A7C15ull;
+}
+
+void ReportHistory::putRecord(std::string & output,
+	std::int64_t time,
+	bool isTaf,
+	std::string_view rawText)
+{
+	RecordHeader header = {};
+	header.time = time;
+	header.length = static_cast<std::uint32_t>(rawText.length());
+	header.type = isTaf ? 1 : 0;
+	output.append(reinterpret_cast<const char *>(&header), sizeof(header));
+	output += rawText;
+}
+
+bool ReportHistory::getRecord(std::string_view data,
+	std::size_t offset,
+	RecordHeader & header,
+	std::string_view & rawText)
+{
+	if (offset > data.size() || data.size() - offset < sizeof(RecordHeader)) return false;
+	std::memcpy(&header, data.data() + offset, sizeof(header));
+	offset += sizeof(RecordHeader);
+	if (data.size() - offset < header.length) return false;
+	rawText = data.substr(offset, header.length);
+	return true;
+}
+
+std::optional<ReportHistory::SegmentTrailer> ReportHistory::trailer(std::string_view segment) {
+	SegmentTrailer t;
+	if (segment.size() < sizeof(t)) return std::optional<SegmentTrailer>();
+	std::memcpy(&t, segment.data() + segment.size() - sizeof(t), sizeof(t));
+	if (std::memcmp(t.magic, segmentMagic, sizeof(t.magic)) ||
+		t.format != segmentFormat ||
+		t.byteOrderMark != byteOrderMark ||
+		t.indexCount > (segment.size() - sizeof(t)) / sizeof(IndexEntry))
+			return std::optional<SegmentTrailer>();
+	return t;
+}
+
+std::filesystem::path ReportHistory::segmentPath(const Station & station,
+	std::uint64_t sequence)
+{
+	// Fixed width keeps segment files sorted by name
+	auto name = std::to_string(sequence);
+	name.insert(0, name.length() < 10 ? 10 - name.length() : 0, '0');
+	return station.directory / (name + segmentExtension);
+}
+
+bool ReportHistory::readFile(const std::filesystem::path & path, std::string & data) {
+	std::ifstream input(path, std::ios::binary);
+	if (!input) return false;
+	data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+	return true;
+}
+
+} //namespace awc
+
+#endif //#ifndef AWC_HISTORY_HPP
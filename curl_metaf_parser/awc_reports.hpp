@@ -0,0 +1,355 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Decoded METAR and TAF reports of Aviation Weather Center dataserver queries              //
+//                                                                                            //
+//   Query keeps its reports between polls and asks the dataserver for the response only      //
+//   if it has changed; unchanged responses are neither downloaded nor parsed again.          //
+//   Reports are indexed by station while the response is parsed. Reports received again      //
+//   by later polls may be looked up in parse cache instead of being parsed again.            //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AWC_REPORTS_HPP
+#define AWC_REPORTS_HPP
+
+#include "METAF.hpp"
+#include "metaf_bulk.hpp"
+#include "metaf_cache.hpp"
+#include "awc_csv.hpp"
+#include "awc_fetch.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace awc {
+
+// Dataserver query URLs; data source is "metars" or "tafs". Server URL
+// may point to another server, e.g. local stand-in for testing.
+static const inline char dataserverUrl[] =
+	"https://aviationweather.gov/adds/dataserver_current/httpparam";
+
+// Reports from all stations within radius (statute miles) of route
+inline std::string flightPathUrl(std::string_view dataSource,
+	const std::vector<std::string> & waypoints,
+	unsigned int radius,
+	unsigned int hoursBeforeNow,
+	std::string_view serverUrl = dataserverUrl);
+
+// Reports from listed stations
+inline std::string stationsUrl(std::string_view dataSource,
+	const std::vector<std::string> & stations,
+	unsigned int hoursBeforeNow,
+	std::string_view serverUrl = dataserverUrl);
+
+// Seconds since Unix epoch of report time; the date is resolved with
+// MetafTime::dateBeforeRef() so that report time is not more than an hour
+// later than reference time (normally the time when the report was
+// received). Returns empty optional if time is invalid.
+inline std::optional<std::int64_t> reportEpoch(const metaf::MetafTime & time,
+	std::chrono::system_clock::time_point reference);
+
+// Seconds since Unix epoch of dataserver time in ISO 8601 format, e.g.
+// 2021-05-25T10:20:00Z; empty optional if time is not in this format
+inline std::optional<std::int64_t> isoEpoch(std::string_view time);
+
+struct StationReport {
+	std::string stationId;
+	std::string rawText;
+	// Never null once the query is complete; result may be shared with
+	// parse cache and with reports of other queries
+	std::shared_ptr<const metaf::ParseResult> result;
+	// Observation time of METAR or issue time of TAF, seconds since Unix
+	// epoch; taken from the response or else resolved from report time
+	std::optional<std::int64_t> time;
+};
+
+// Reports returned by one dataserver query (one data source and route).
+// Requests are conditional: validators (ETag and Last-Modified) of the
+// last response are sent with the request, and on 304 Not Modified the
+// kept reports are reused as they are.
+class ReportQuery {
+public:
+	using CompletionHandler =
+		std::function<void(const ReportQuery &, const FetchResult &)>;
+	// Station ID to indexes of its reports in reports(), latest report
+	// time first
+	using StationIndex =
+		std::unordered_map<std::string, std::vector<std::size_t>>;
+
+	// Reports are decoded as soon as their records are received; if bulk
+	// parser is given, reports are instead decoded in parallel when the
+	// response is complete. If parse cache is given, results are taken
+	// from the cache. Parser and cache must outlive the query.
+	inline explicit ReportQuery(std::string url,
+		metaf::BulkParser * bulkParser = nullptr,
+		metaf::ParseCache * parseCache = nullptr);
+	ReportQuery(const ReportQuery &) = delete;
+	ReportQuery & operator=(const ReportQuery &) = delete;
+
+	const std::string & url() const { return queryUrl; }
+
+	// Builds request which receives and decodes the response into this
+	// query. Only one request of the query may be in progress at a time.
+	inline FetchRequest request(CompletionHandler onComplete = nullptr);
+
+	// Reports in the order of the response
+	const std::vector<StationReport> & reports() const { return current; }
+	const StationIndex & stations() const { return currentIndex; }
+	// Indexes of the station's reports in reports(), latest report time first
+	inline const std::vector<std::size_t> & stationReports(
+		std::string_view stationId) const;
+	// Latest report of the station, or nullptr if there is none
+	inline const StationReport * latest(std::string_view stationId) const;
+	const std::vector<std::string> & errors() const { return dataserverErrors; }
+	// True if the last request received new reports, false if reports
+	// were not modified or the request failed and old reports were kept
+	bool isModified() const { return modified; }
+
+private:
+	inline void complete(const FetchResult & result);
+
+	inline static std::shared_ptr<const metaf::ParseResult> parse(
+		std::string_view report,
+		metaf::ParseContext & context,
+		metaf::ParseCache * cache);
+
+	std::string queryUrl;
+	metaf::BulkParser * parser;
+	metaf::ParseCache * cache;
+	// Used when reports are decoded as soon as they are received
+	metaf::ParseContext context;
+	std::string etag;
+	std::string lastModified;
+	CsvParser csv;
+	std::vector<StationReport> received;
+	std::vector<StationReport> current;
+	StationIndex receivedIndex;
+	StationIndex currentIndex;
+	std::vector<std::string> dataserverErrors;
+	bool modified = false;
+};
+
+std::string flightPathUrl(std::string_view dataSource,
+	const std::vector<std::string> & waypoints,
+	unsigned int radius,
+	unsigned int hoursBeforeNow,
+	std::string_view serverUrl)
+{
+	std::string url(serverUrl);
+	url += "?dataSource=";
+	url += dataSource;
+	url += "&requestType=retrieve&format=csv&flightPath=";
+	url += std::to_string(radius);
+	for (const auto & waypoint : waypoints) {
+		url += ';';
+		url += waypoint;
+	}
+	url += "&hoursBeforeNow=";
+	url += std::to_string(hoursBeforeNow);
+	return url;
+}
+
+std::string stationsUrl(std::string_view dataSource,
+	const std::vector<std::string> & stations,
+	unsigned int hoursBeforeNow,
+	std::string_view serverUrl)
+{
+	std::string url(serverUrl);
+	url += "?dataSource=";
+	url += dataSource;
+	url += "&requestType=retrieve&format=csv&stationString=";
+	for (std::size_t i = 0; i < stations.size(); i++) {
+		if (i) url += ',';
+		url += stations[i];
+	}
+	url += "&hoursBeforeNow=";
+	url += std::to_string(hoursBeforeNow);
+	return url;
+}
+
+namespace detail {
+
+// Days since 1970-01-01 of a date of proleptic Gregorian calendar
+inline std::int64_t daysFromCivil(std::int64_t y, unsigned int m, unsigned int d) {
+	y -= (m <= 2);
+	const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+	const auto yoe = static_cast<unsigned int>(y - era * 400);
+	const unsigned int doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+	const unsigned int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+inline metaf::MetafTime::Date civilFromDays(std::int64_t z) {
+	z += 719468;
+	const std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+	const auto doe = static_cast<unsigned int>(z - era * 146097);
+	const unsigned int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	const unsigned int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	const unsigned int mp = (5 * doy + 2) / 153;
+	const unsigned int d = doy - (153 * mp + 2) / 5 + 1;
+	const unsigned int m = (mp < 10) ? mp + 3 : mp - 9;
+	const auto y = static_cast<unsigned int>(yoe + era * 400 + (m <= 2));
+	return metaf::MetafTime::Date(y, m, d);
+}
+
+} //namespace detail
+
+std::optional<std::int64_t> reportEpoch(const metaf::MetafTime & time,
+	std::chrono::system_clock::time_point reference)
+{
+	if (!time.isValid()) return std::optional<std::int64_t>();
+	const auto referenceSeconds = std::chrono::duration_cast<std::chrono::seconds>(
+		reference.time_since_epoch()).count();
+	static const std::int64_t secondsPerDay = 24 * 3600;
+	// Report time may be up to an hour later than reference time because of
+	// clock differences; later times are of the previous day (time without
+	// day) or of the previous month
+	const auto latest = referenceSeconds + 3600;
+	const auto resolve = [&time](std::int64_t referenceDay) {
+		const auto date = time.dateBeforeRef(detail::civilFromDays(referenceDay));
+		return detail::daysFromCivil(date.year, date.month, date.day) * secondsPerDay +
+			std::int64_t(time.hour()) * 3600 + std::int64_t(time.minute()) * 60;
+	};
+	auto latestDay = latest / secondsPerDay;
+	if (latest % secondsPerDay < 0) latestDay--;
+	const auto result = resolve(latestDay);
+	if (result <= latest) return result;
+	return resolve(latestDay - 1);
+}
+
+std::optional<std::int64_t> isoEpoch(std::string_view time) {
+	// YYYY-MM-DDThh:mm:ssZ
+	static const std::string_view format = "0000-00-00T00:00:00Z";
+	if (time.length() != format.length()) return std::optional<std::int64_t>();
+	for (std::size_t i = 0; i < format.length(); i++) {
+		const bool digit = (time[i] >= '0' && time[i] <= '9');
+		if (format[i] == '0' ? !digit : time[i] != format[i])
+			return std::optional<std::int64_t>();
+	}
+	const auto number = [time](std::size_t pos, std::size_t length) {
+		unsigned int result = 0;
+		for (std::size_t i = pos; i < pos + length; i++)
+			result = result * 10 + static_cast<unsigned int>(time[i] - '0');
+		return result;
+	};
+	const auto month = number(5, 2), day = number(8, 2);
+	const auto hour = number(11, 2), minute = number(14, 2), second = number(17, 2);
+	if (month < 1 || month > 12 || day < 1 || day > 31 ||
+		hour > 23 || minute > 59 || second > 59) return std::optional<std::int64_t>();
+	return detail::daysFromCivil(number(0, 4), month, day) * 24 * 3600 +
+		std::int64_t(hour) * 3600 + std::int64_t(minute) * 60 + second;
+}
+
+ReportQuery::ReportQuery(std::string url,
+	metaf::BulkParser * bulkParser,
+	metaf::ParseCache * parseCache) :
+	queryUrl(std::move(url)),
+	parser(bulkParser),
+	cache(parseCache),
+	csv([this](const CsvRecord & record) {
+		StationReport report;
+		report.stationId = std::string(record.stationId());
+		report.rawText = std::string(record.rawText());
+		report.time = isoEpoch(record.field("observation_time"));
+		if (!report.time.has_value()) report.time = isoEpoch(record.field("issue_time"));
+		if (!parser) report.result = parse(report.rawText, context, cache);
+		if (!report.stationId.empty())
+			receivedIndex[report.stationId].push_back(received.size());
+		received.push_back(std::move(report));
+	})
+{
+}
+
+FetchRequest ReportQuery::request(CompletionHandler onComplete) {
+	csv.reset();
+	received.clear();
+	receivedIndex.clear();
+	FetchRequest request;
+	request.url = queryUrl;
+	if (!etag.empty()) request.headers.push_back("If-None-Match: " + etag);
+	if (!lastModified.empty())
+		request.headers.push_back("If-Modified-Since: " + lastModified);
+	request.onBody = [this](const char * data, std::size_t size) {
+		csv.feed(data, size);
+	};
+	request.onComplete = [this, onComplete](const FetchRequest &,
+		const FetchResult & result)
+	{
+		complete(result);
+		if (onComplete) onComplete(*this, result);
+	};
+	return request;
+}
+
+const std::vector<std::size_t> & ReportQuery::stationReports(
+	std::string_view stationId) const
+{
+	static const std::vector<std::size_t> none;
+	const auto it = currentIndex.find(std::string(stationId));
+	if (it == currentIndex.end()) return none;
+	return it->second;
+}
+
+const StationReport * ReportQuery::latest(std::string_view stationId) const {
+	const auto & indexes = stationReports(stationId);
+	if (indexes.empty()) return nullptr;
+	return &current[indexes.front()];
+}
+
+std::shared_ptr<const metaf::ParseResult> ReportQuery::parse(std::string_view report,
+	metaf::ParseContext & context,
+	metaf::ParseCache * cache)
+{
+	if (cache) return cache->parse(report, context);
+	return std::make_shared<const metaf::ParseResult>(metaf::Parser::parse(report, context));
+}
+
+void ReportQuery::complete(const FetchResult & result) {
+	modified = false;
+	if (result.isOk() && !result.isNotModified()) {
+		csv.finish();
+		if (parser) {
+			parser->run(received.size(), [this](std::size_t index,
+				metaf::ParseContext & context)
+			{
+				received[index].result = parse(received[index].rawText, context, cache);
+			});
+		}
+		// Response lists reports oldest first; reports of unknown time are
+		// placed after the others
+		const auto now = std::chrono::system_clock::now();
+		for (auto & report : received) {
+			const auto & reportTime = report.result->reportMetadata.reportTime;
+			if (!report.time.has_value() && reportTime.has_value())
+				report.time = reportEpoch(*reportTime, now);
+		}
+		for (auto & station : receivedIndex) {
+			std::stable_sort(station.second.begin(), station.second.end(),
+				[this](std::size_t lhs, std::size_t rhs) {
+					const auto & l = received[lhs].time;
+					const auto & r = received[rhs].time;
+					return (l.has_value() && (!r.has_value() || *l > *r));
+				});
+		}
+		current.swap(received);
+		currentIndex.swap(receivedIndex);
+		dataserverErrors = csv.errors();
+		// Response with dataserver errors is not worth keeping validators
+		etag = dataserverErrors.empty() ? result.etag : std::string();
+		lastModified = dataserverErrors.empty() ? result.lastModified : std::string();
+		modified = true;
+	}
+	received.clear();
+	receivedIndex.clear();
+}
+
+} //namespace awc
+
+#endif //#ifndef AWC_REPORTS_HPP
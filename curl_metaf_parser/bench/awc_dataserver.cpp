@@ -0,0 +1,374 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Local stand-in for Aviation Weather Center dataserver                                    //
+//                                                                                            //
+//   Serves recorded CSV responses over HTTP/1.1 so that fetching, CSV and report parsing     //
+//   and rendering can be benchmarked and load-tested without network access. Response to     //
+//   dataSource=<name> is file <name>.csv from responses directory; other query parameters    //
+//   are ignored. ETag and Last-Modified are sent, conditional requests get 304.              //
+//                                                                                            //
+//   Build:  make awc_dataserver   (POSIX only)                                               //
+//   Usage:  awc_dataserver [options]                                                         //
+//     -p, --port N              port to listen on, localhost only (default 8080)             //
+//     -d, --dir DIR             recorded responses directory (default responses)             //
+//     --latency MS              delay before response is sent (default 0)                    //
+//     --bandwidth BYTES         bytes per second per connection, 0 = unlimited (default 0)   //
+//     --chunk BYTES             send body with chunked encoding in chunks of this size,      //
+//                               0 = whole body with Content-Length (default 0)               //
+//     --repeat N                repeat records of every response N times (default 1)         //
+//     --error-rate P            fraction of requests answered with 503 (default 0)           //
+//     --dataserver-error-rate P fraction of requests answered with dataserver error in       //
+//                               CSV preamble and no results (default 0)                      //
+//     --drop-rate P             fraction of requests where connection is closed in the       //
+//                               middle of the body (default 0)                               //
+//     --seed N                  random seed for error injection (default 1)                  //
+//     -v, --verbose             print every request                                          //
+//   Dataserver URL for clients: http://127.0.0.1:<port>/adds/dataserver_current/httpparam    //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct Options {
+    int port = 8080;
+    string dir = "responses";
+    int latencyMs = 0;
+    size_t bandwidth = 0;
+    size_t chunk = 0;
+    int repeat = 1;
+    double errorRate = 0.0;
+    double dataserverErrorRate = 0.0;
+    double dropRate = 0.0;
+    unsigned int seed = 1;
+    bool verbose = false;
+};
+
+struct Response {
+    string body;
+    string etag;
+};
+
+static Options options;
+static map<string, Response> responses;
+static string lastModified;
+
+static mutex randomMutex;
+static mt19937 randomEngine;
+
+static atomic<size_t> requestCount(0);
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool happens(double probability) {
+    if (probability <= 0.0) return false;
+    lock_guard<mutex> lock(randomMutex);
+    return (uniform_real_distribution<double>(0.0, 1.0)(randomEngine) < probability);
+}
+
+static string httpDate(time_t t) {
+    char buffer[64];
+    strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", gmtime(&t));
+    return buffer;
+}
+
+// Records of the recorded response are repeated, preamble and header line
+// are kept; number of results in preamble is updated
+static string repeatRecords(const string & csv, int repeat) {
+    istringstream input(csv);
+    string line, preamble, records;
+    bool header = false;
+    size_t count = 0;
+    while (getline(input, line)) {
+        if (!header) {
+            preamble += line + '\n';
+            header = (line.compare(0, 9, "raw_text,") == 0);
+            continue;
+        }
+        if (line.empty()) continue;
+        records += line + '\n';
+        count++;
+    }
+    const auto resultsPos = preamble.find(" results\n");
+    if (resultsPos != string::npos) {
+        const auto lineBegin = preamble.rfind('\n', resultsPos);
+        const auto begin = (lineBegin == string::npos) ? 0 : lineBegin + 1;
+        preamble.replace(begin, resultsPos - begin, to_string(count * repeat));
+    }
+    string result = preamble;
+    for (int i = 0; i < repeat; i++) result += records;
+    return result;
+}
+
+static bool loadResponse(const string & dataSource) {
+    ifstream file(options.dir + "/" + dataSource + ".csv", ios::binary);
+    if (!file) return false;
+    stringstream content;
+    content << file.rdbuf();
+    Response response;
+    response.body = repeatRecords(content.str(), options.repeat);
+    // FNV-1a hash of the body serves as ETag
+    uint64_t hash = 14695981039346656037ull;
+    for (const auto c : response.body) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    ostringstream etag;
+    etag << '"' << hex << hash << '"';
+    response.etag = etag.str();
+    responses[dataSource] = move(response);
+    return true;
+}
+
+static string dataserverError(const string & dataSource, const string & message) {
+    return "errors\n" + message + "\nNo warnings\n1 ms\ndata source=" + dataSource +
+        "\n0 results\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static string queryParameter(const string & target, const string & name) {
+    const auto query = target.find('?');
+    if (query == string::npos) return string();
+    size_t pos = query + 1;
+    while (pos < target.length()) {
+        auto end = target.find('&', pos);
+        if (end == string::npos) end = target.length();
+        const auto equals = target.find('=', pos);
+        if (equals < end && target.compare(pos, equals - pos, name) == 0)
+            return target.substr(equals + 1, end - equals - 1);
+        pos = end + 1;
+    }
+    return string();
+}
+
+static string headerValue(const string & headers, const string & name) {
+    istringstream input(headers);
+    string line;
+    while (getline(input, line)) {
+        if (line.length() <= name.length() || line[name.length()] != ':') continue;
+        bool match = true;
+        for (size_t i = 0; i < name.length() && match; i++)
+            match = (tolower(static_cast<unsigned char>(line[i])) == name[i]);
+        if (!match) continue;
+        auto value = line.substr(name.length() + 1);
+        value.erase(0, value.find_first_not_of(" \t"));
+        value.erase(value.find_last_not_of(" \t\r") + 1);
+        return value;
+    }
+    return string();
+}
+
+// Sends data, limited to configured bandwidth; false if connection failed
+static bool sendAll(int socket, const char * data, size_t size) {
+    const size_t slice = options.bandwidth ? max<size_t>(options.bandwidth / 20, 1) : size;
+    while (size) {
+        const auto started = chrono::steady_clock::now();
+        const auto part = min(slice, size);
+        size_t sent = 0;
+        while (sent < part) {
+            const auto result = send(socket, data + sent, part - sent, MSG_NOSIGNAL);
+            if (result <= 0) return false;
+            sent += static_cast<size_t>(result);
+        }
+        data += part;
+        size -= part;
+        if (options.bandwidth && size) {
+            this_thread::sleep_until(started +
+                chrono::microseconds(part * 1000000 / options.bandwidth));
+        }
+    }
+    return true;
+}
+
+static bool sendString(int socket, const string & s) {
+    return sendAll(socket, s.data(), s.length());
+}
+
+// Sends response; false if connection is to be closed
+static bool respond(int socket, const string & target, const string & headers) {
+    const auto dataSource = queryParameter(target, "dataSource");
+    const auto keepAlive = (headerValue(headers, "connection") != "close");
+    const auto number = ++requestCount;
+    if (options.verbose) cout << number << " GET " << target << endl;
+
+    if (options.latencyMs)
+        this_thread::sleep_for(chrono::milliseconds(options.latencyMs));
+
+    string status = "200 OK";
+    string body;
+    string extraHeaders;
+    bool drop = false;
+    const auto response = responses.find(dataSource);
+    if (happens(options.errorRate)) {
+        status = "503 Service Unavailable";
+        body = "Service temporarily unavailable\n";
+    } else if (response == responses.end()) {
+        body = dataserverError(dataSource, "Invalid datasource: " + dataSource);
+    } else if (happens(options.dataserverErrorRate)) {
+        body = dataserverError(dataSource, "Query timed out (injected error)");
+    } else {
+        extraHeaders = "ETag: " + response->second.etag + "\r\n" +
+            "Last-Modified: " + lastModified + "\r\n";
+        if (headerValue(headers, "if-none-match") == response->second.etag ||
+            headerValue(headers, "if-modified-since") == lastModified)
+        {
+            status = "304 Not Modified";
+        } else {
+            body = response->second.body;
+            drop = happens(options.dropRate);
+        }
+    }
+
+    const bool chunked = (options.chunk && !body.empty());
+    string head = "HTTP/1.1 " + status + "\r\nContent-Type: text/plain\r\n" + extraHeaders;
+    if (status.compare(0, 3, "304")) {
+        if (chunked) head += "Transfer-Encoding: chunked\r\n";
+        else head += "Content-Length: " + to_string(body.length()) + "\r\n";
+    }
+    head += keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+    if (!sendString(socket, head)) return false;
+
+    // Dropped connection sends half of the body only
+    const auto bodyLength = drop ? body.length() / 2 : body.length();
+    if (!chunked) {
+        if (!sendAll(socket, body.data(), bodyLength)) return false;
+    } else {
+        for (size_t pos = 0; pos < bodyLength; pos += options.chunk) {
+            const auto size = min(options.chunk, bodyLength - pos);
+            ostringstream chunkHead;
+            chunkHead << hex << size << "\r\n";
+            if (!sendString(socket, chunkHead.str()) ||
+                !sendAll(socket, body.data() + pos, size) ||
+                !sendString(socket, "\r\n")) return false;
+        }
+        if (!drop && !sendString(socket, "0\r\n\r\n")) return false;
+    }
+    return (keepAlive && !drop);
+}
+
+static void serveConnection(int socket) {
+    const int noDelay = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    string received;
+    char buffer[4096];
+    while (true) {
+        const auto headersEnd = received.find("\r\n\r\n");
+        if (headersEnd == string::npos) {
+            const auto result = recv(socket, buffer, sizeof(buffer), 0);
+            if (result <= 0) break;
+            received.append(buffer, static_cast<size_t>(result));
+            continue;
+        }
+        const auto request = received.substr(0, headersEnd + 2);
+        received.erase(0, headersEnd + 4);
+        const auto lineEnd = request.find("\r\n");
+        istringstream requestLine(request.substr(0, lineEnd));
+        string method, target;
+        requestLine >> method >> target;
+        if (method != "GET") {
+            sendString(socket, "HTTP/1.1 405 Method Not Allowed\r\n"
+                "Content-Length: 0\r\nConnection: close\r\n\r\n");
+            break;
+        }
+        if (!respond(socket, target, request.substr(lineEnd + 2))) break;
+    }
+    close(socket);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool parseOptions(int argc, char ** argv) {
+    try {
+        for (int i = 1; i < argc; i++) {
+            const string arg = argv[i];
+            if (arg == "-v" || arg == "--verbose") {
+                options.verbose = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                cerr << "Missing value of " << arg << endl;
+                return false;
+            }
+            const string value = argv[++i];
+            if (arg == "-p" || arg == "--port") options.port = stoi(value);
+            else if (arg == "-d" || arg == "--dir") options.dir = value;
+            else if (arg == "--latency") options.latencyMs = stoi(value);
+            else if (arg == "--bandwidth") options.bandwidth = stoul(value);
+            else if (arg == "--chunk") options.chunk = stoul(value);
+            else if (arg == "--repeat") options.repeat = max(stoi(value), 1);
+            else if (arg == "--error-rate") options.errorRate = stod(value);
+            else if (arg == "--dataserver-error-rate") options.dataserverErrorRate = stod(value);
+            else if (arg == "--drop-rate") options.dropRate = stod(value);
+            else if (arg == "--seed") options.seed = stoul(value);
+            else {
+                cerr << "Unknown option " << arg << endl;
+                return false;
+            }
+        }
+    } catch (const exception &) {
+        cerr << "Invalid option value" << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char ** argv) {
+    if (!parseOptions(argc, argv)) return 1;
+    randomEngine.seed(options.seed);
+    lastModified = httpDate(time(nullptr));
+    for (const auto dataSource : { "metars", "tafs" }) {
+        if (!loadResponse(dataSource)) {
+            cerr << "Cannot read " << options.dir << "/" << dataSource << ".csv" << endl;
+            return 1;
+        }
+    }
+
+    const int listener = socket(AF_INET, SOCK_STREAM, 0);
+    const int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(options.port));
+    if (listener < 0 ||
+        ::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) ||
+        listen(listener, 128))
+    {
+        cerr << "Cannot listen on port " << options.port << ": " << strerror(errno) << endl;
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+    cout << "Dataserver stand-in: http://127.0.0.1:" << options.port
+        << "/adds/dataserver_current/httpparam" << endl;
+
+    while (true) {
+        const int socket = accept(listener, nullptr, nullptr);
+        if (socket < 0) continue;
+        thread(serveConnection, socket).detach();
+    }
+}
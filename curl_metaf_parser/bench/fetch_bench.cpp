@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Fetch pipeline benchmark                                                                 //
+//                                                                                            //
+//   Polls dataserver in rounds like the daemon does: every round runs METAR and TAF query    //
+//   of each route at once through FetchEngine; responses are parsed as CSV and decoded by    //
+//   ReportQuery while received, then decoded groups of changed responses are rendered.       //
+//   Reports of each station are checked to be indexed latest report time first.              //
+//   Meant to be run against local stand-in dataserver (awc_dataserver), see "make fetch".    //
+//                                                                                            //
+//   Build:  make fetch_bench   (needs libcurl)                                               //
+//   Usage:  fetch_bench [options]                                                            //
+//     -u, --url URL        dataserver URL                                                    //
+//                          (default http://127.0.0.1:8080/adds/dataserver_current/httpparam) //
+//     -n, --rounds N       polling rounds (default 20)                                       //
+//     -q, --queries N      routes polled in every round (default 10)                         //
+//     -p, --pool N         FetchEngine pool size (default 32)                                //
+//     --no-cache           new queries every round: no conditional requests                  //
+//     --parse-cache MB     look up reports in ParseCache of given size (default 0, no cache) //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "METAF.hpp"
+#include "awc_reports.hpp"
+#include "metaf_cache.hpp"
+#include "render_visitor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct Options {
+    string url = "http://127.0.0.1:8080/adds/dataserver_current/httpparam";
+    int rounds = 20;
+    int queries = 10;
+    size_t poolSize = 32;
+    bool cache = true;
+    size_t parseCacheSize = 0;
+};
+
+struct Totals {
+    size_t requests = 0;
+    size_t failed = 0;
+    size_t notModified = 0;
+    size_t reusedConnections = 0;
+    double requestSeconds = 0.0;
+    double connectSeconds = 0.0;
+    size_t wireBytes = 0;
+    size_t decodedBytes = 0;
+    size_t reports = 0;
+    size_t misordered = 0;
+    size_t groups = 0;
+    size_t renderedLength = 0;
+    double renderSeconds = 0.0;
+    double maxRoundSeconds = 0.0;
+};
+
+static bool parseOptions(int argc, char ** argv, Options & options) {
+    try {
+        for (int i = 1; i < argc; i++) {
+            const string arg = argv[i];
+            if (arg == "--no-cache") {
+                options.cache = false;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                cerr << "Missing value of " << arg << endl;
+                return false;
+            }
+            const string value = argv[++i];
+            if (arg == "-u" || arg == "--url") options.url = value;
+            else if (arg == "-n" || arg == "--rounds") options.rounds = max(stoi(value), 1);
+            else if (arg == "-q" || arg == "--queries") options.queries = max(stoi(value), 1);
+            else if (arg == "-p" || arg == "--pool") options.poolSize = stoul(value);
+            else if (arg == "--parse-cache") options.parseCacheSize = stoul(value) * 1024 * 1024;
+            else {
+                cerr << "Unknown option " << arg << endl;
+                return false;
+            }
+        }
+    } catch (const exception &) {
+        cerr << "Invalid option value" << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char ** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    static const vector<string> stations = {
+        "UKBB", "UKOO", "UKKK", "UKLL", "EGLL", "LFPG", "EDDF", "KJFK", "KORD", "CYYZ"
+    };
+    // Parse cache is kept across rounds, also when queries are not
+    metaf::ParseCache parseCache(options.parseCacheSize);
+    auto makeQueries = [&] {
+        vector<unique_ptr<awc::ReportQuery>> queries;
+        for (int i = 0; i < options.queries; i++) {
+            const vector<string> route = {
+                stations[i % stations.size()], stations[(i + 1) % stations.size()]
+            };
+            for (const auto dataSource : { "metars", "tafs" }) {
+                queries.push_back(make_unique<awc::ReportQuery>(
+                    awc::flightPathUrl(dataSource, route, 50, 2, options.url), nullptr,
+                    options.parseCacheSize ? &parseCache : nullptr));
+            }
+        }
+        return queries;
+    };
+
+    awc::FetchEngine engine(options.poolSize);
+    RenderVisitor visitor;
+    Totals totals;
+    auto queries = makeQueries();
+    const auto started = chrono::steady_clock::now();
+    for (int round = 0; round < options.rounds; round++) {
+        if (!options.cache) queries = makeQueries();
+        const auto roundStarted = chrono::steady_clock::now();
+        for (auto & query : queries) {
+            engine.add(query->request([&](const awc::ReportQuery & q,
+                const awc::FetchResult & r)
+            {
+                totals.requests++;
+                totals.requestSeconds += r.seconds;
+                totals.connectSeconds += r.connectSeconds;
+                totals.wireBytes += r.wireBytes;
+                totals.decodedBytes += r.decodedBytes;
+                if (r.isReusedConnection) totals.reusedConnections++;
+                if (!r.isOk() || !q.errors().empty()) totals.failed++;
+                if (r.isNotModified()) totals.notModified++;
+            }));
+        }
+        engine.run();
+
+        for (const auto & query : queries) {
+            if (!query->isModified()) continue;
+            for (const auto & station : query->stations()) {
+                const auto & indexes = station.second;
+                for (size_t i = 1; i < indexes.size(); i++) {
+                    const auto & previous = query->reports()[indexes[i - 1]].time;
+                    const auto & next = query->reports()[indexes[i]].time;
+                    if (next.has_value() && (!previous.has_value() || *previous < *next))
+                        totals.misordered++;
+                }
+            }
+        }
+
+        const auto renderStarted = chrono::steady_clock::now();
+        for (const auto & query : queries) {
+            if (!query->isModified()) continue;
+            for (const auto & report : query->reports()) {
+                totals.reports++;
+                for (const auto & groupInfo : report.result->groups) {
+                    totals.renderedLength += visitor.visit(groupInfo).length();
+                    totals.groups++;
+                }
+            }
+        }
+        const auto finished = chrono::steady_clock::now();
+        totals.renderSeconds += chrono::duration<double>(finished - renderStarted).count();
+        totals.maxRoundSeconds = max(totals.maxRoundSeconds,
+            chrono::duration<double>(finished - roundStarted).count());
+    }
+    const double seconds =
+        chrono::duration<double>(chrono::steady_clock::now() - started).count();
+
+    const auto percent = [](size_t part, size_t whole) {
+        return whole ? 100.0 * part / whole : 0.0;
+    };
+    cout << fixed << setprecision(2);
+    cout << "rounds:              " << options.rounds << " x " << queries.size()
+        << " requests, " << seconds << " s" << endl;
+    cout << "round time:          " << seconds * 1000 / options.rounds << " ms average, "
+        << totals.maxRoundSeconds * 1000 << " ms max" << endl;
+    cout << "requests:            " << totals.requests << ", " << totals.failed << " failed, "
+        << totals.notModified << " not modified" << endl;
+    cout << "request time:        " << totals.requestSeconds * 1000 / totals.requests
+        << " ms average, " << totals.connectSeconds * 1000 / totals.requests
+        << " ms of it connecting" << endl;
+    cout << "reused connections:  " << percent(totals.reusedConnections, totals.requests)
+        << " %" << endl;
+    cout << "received:            " << totals.wireBytes << " bytes on wire, "
+        << totals.decodedBytes << " bytes decoded" << endl;
+    cout << "decoded reports:     " << totals.reports << ", "
+        << totals.reports / seconds << " reports/s" << endl;
+    if (totals.misordered)
+        cout << "misordered reports:  " << totals.misordered << endl;
+    cout << "rendered groups:     " << totals.groups << ", "
+        << (totals.groups ? totals.renderSeconds * 1e9 / totals.groups : 0.0)
+        << " ns/group, " << totals.renderedLength << " chars" << endl;
+    if (options.parseCacheSize) {
+        const auto cache = parseCache.statistics();
+        cout << "parse cache:         " << cache.hits << " hits ("
+            << percent(cache.hits, cache.hits + cache.misses) << " %), " << cache.misses
+            << " misses, " << cache.evictions << " evictions, " << cache.entries
+            << " entries, " << cache.bytes / 1024 << " KiB" << endl;
+    }
+    return ((totals.failed || totals.misordered) ? 2 : 0);
+}
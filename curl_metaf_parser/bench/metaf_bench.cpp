@@ -0,0 +1,544 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   METAF parser benchmark suite                                                             //
+//                                                                                            //
+//   Parses every report of each corpus file (one raw METAR or TAF per line) and measures:    //
+//   - throughput of Parser::parse, Parser::parseBatch with reusable ParseContext,            //
+//     multi-threaded BulkParser, Parser::parseLazy when only groups before remarks are       //
+//     accessed, and Parser::parseMetadata;                                                   //
+//   - memory allocations per report for Parser::parse and Parser::parseBatch;                //
+//   - cost of rendering parsed groups with Visitor;                                          //
+//   - loading columnar snapshot of parsed reports and scanning its columns;                  //
+//   - encoded size of reports with built-in and trained ReportDictionary, encoding and       //
+//     decoding rate, decoding followed by Parser::parse vs ReportCodec::decodeGroups         //
+//     followed by Parser::parseGroups;                                                       //
+//   - lookup of reports in ParseCache when every report is cached;                           //
+//   - parse cost per group type (GroupParser::parse of the first group string only,          //
+//     appended group strings are not included).                                              //
+//   Each measurement is repeated and the best run is reported. Results may be saved as       //
+//   JSON and compared with previously saved results to detect regressions.                   //
+//                                                                                            //
+//   Build:  make   (or g++ -std=c++17 -O2 -pthread -I.. metaf_bench.cpp -o metaf_bench)       //
+//   Usage:  metaf_bench [options] [corpus files]                                             //
+//     -i, --iterations N   corpus passes per measurement (default 200)                       //
+//     -r, --repeats N      measurements per metric, best one is reported (default 3)         //
+//     -t, --threads N      BulkParser threads, 0 = all hardware threads (default 0)          //
+//     -j, --json FILE      save results to FILE                                              //
+//     -b, --baseline FILE  compare results with FILE saved earlier by --json; exit code      //
+//                          is 2 if any metric is worse than baseline by more than tolerance  //
+//     --tolerance PCT      allowed difference from baseline in percent (default 10)          //
+//   Default corpus files are corpus/icao.txt, corpus/us.txt and corpus/malformed.txt.        //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "METAF.hpp"
+#include "metaf_bulk.hpp"
+#include "metaf_cache.hpp"
+#include "metaf_codec.hpp"
+#include "metaf_snapshot.hpp"
+#include "render_visitor.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace metaf;
+
+///////////////////////////////////////////////////////////////////////////////
+// Allocation counting: every operator new in this program is counted
+
+#if !defined(__clang__) && defined(__GNUC__) && (__GNUC__ >= 11)
+    // GCC gives false positives when replaced operator delete is inlined
+    #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+static atomic<size_t> allocationCount(0);
+
+void * operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void * p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void * operator new[](size_t size) { return operator new(size); }
+void operator delete(void * p) noexcept { free(p); }
+void operator delete[](void * p) noexcept { free(p); }
+void operator delete(void * p, size_t) noexcept { free(p); }
+void operator delete[](void * p, size_t) noexcept { free(p); }
+
+///////////////////////////////////////////////////////////////////////////////
+
+static const char * const groupTypeNames[] = {
+    "KeywordGroup", "LocationGroup", "ReportTimeGroup", "TrendGroup",
+    "WindGroup", "VisibilityGroup", "CloudGroup", "WeatherGroup",
+    "TemperatureGroup", "PressureGroup", "RunwayStateGroup", "SeaSurfaceGroup",
+    "MinMaxTemperatureGroup", "PrecipitationGroup", "LayerForecastGroup",
+    "PressureTendencyGroup", "CloudTypesGroup", "LowMidHighCloudGroup",
+    "LightningGroup", "VicinityGroup", "MiscGroup", "UnknownGroup"
+};
+static_assert(sizeof(groupTypeNames) / sizeof(groupTypeNames[0]) == variant_size_v<Group>,
+    "Group type names do not match Group alternatives");
+
+struct Options {
+    int iterations = 200;
+    int repeats = 3;
+    unsigned int threads = 0;
+    string jsonFile;
+    string baselineFile;
+    double tolerance = 10.0;
+    vector<string> corpusFiles;
+};
+
+struct Corpus {
+    string name;
+    vector<string> reports;
+};
+
+// Metric name and value; names ending with "_per_s" are 'higher is better',
+// all other metrics are 'lower is better'
+using Metrics = vector<pair<string, double>>;
+
+// Runs task the number of times given by repeats and returns best time in seconds
+template <typename Task>
+static double bestSeconds(int repeats, Task && task) {
+    double best = 0.0;
+    for (int i = 0; i < repeats; i++) {
+        const auto start = chrono::steady_clock::now();
+        task();
+        const auto finish = chrono::steady_clock::now();
+        const double seconds = chrono::duration<double>(finish - start).count();
+        if (!i || seconds < best) best = seconds;
+    }
+    return best;
+}
+
+static bool higherIsBetter(const string & metric) {
+    static const string suffix = "_per_s";
+    return (metric.length() >= suffix.length() &&
+        metric.compare(metric.length() - suffix.length(), suffix.length(), suffix) == 0);
+}
+
+static string corpusName(const string & file) {
+    auto name = file.substr(file.find_last_of("/\\") + 1);
+    return name.substr(0, name.find('.'));
+}
+
+static bool readCorpus(const string & file, Corpus & corpus) {
+    ifstream input(file);
+    if (!input) return false;
+    corpus.name = corpusName(file);
+    for (string line; getline(input, line); )
+        if (!line.empty()) corpus.reports.push_back(line);
+    return !corpus.reports.empty();
+}
+
+static void benchmarkCorpus(const Corpus & corpus,
+    const Options & options,
+    BulkParser & bulkParser,
+    Metrics & metrics)
+{
+    const auto & reports = corpus.reports;
+    const double parsedReports = double(reports.size()) * options.iterations;
+    auto add = [&](const string & name, double value) {
+        metrics.emplace_back(corpus.name + "." + name, value);
+    };
+
+    // Warm-up pass, also counts groups per corpus pass
+    size_t groupsPerPass = 0;
+    for (const auto & report : reports)
+        groupsPerPass += Parser::parse(report).groups.size();
+    const double parsedGroups = double(groupsPerPass) * options.iterations;
+
+    const double parseSeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            for (const auto & report : reports)
+                Parser::parse(report);
+    });
+    add("parse_reports_per_s", parsedReports / parseSeconds);
+    add("parse_groups_per_s", parsedGroups / parseSeconds);
+    add("parse_us_per_report", parseSeconds * 1e6 / parsedReports);
+
+    ParseContext context;
+    const double batchSeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            Parser::parseBatch(reports, context, [](size_t, const ParseResult &) {});
+    });
+    add("batch_reports_per_s", parsedReports / batchSeconds);
+
+    const double bulkSeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            bulkParser.parse(reports);
+    });
+    add("bulk_reports_per_s", parsedReports / bulkSeconds);
+
+    // Only header and report body are accessed, remarks are not parsed
+    LazyParseResult lazyResult;
+    const double lazySeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            for (const auto & report : reports) {
+                Parser::parseLazy(report, lazyResult);
+                for (size_t j = 0; const auto group = lazyResult.group(j); j++)
+                    if (group->reportPart == ReportPart::RMK) break;
+            }
+    });
+    add("lazy_reports_per_s", parsedReports / lazySeconds);
+
+    const double metadataSeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            for (const auto & report : reports)
+                Parser::parseMetadata(report);
+    });
+    add("metadata_reports_per_s", parsedReports / metadataSeconds);
+
+    // Allocations are the same in every pass, single pass is enough
+    const auto parseAllocationsBefore = allocationCount.load();
+    for (const auto & report : reports)
+        Parser::parse(report);
+    const auto parseAllocations = allocationCount.load() - parseAllocationsBefore;
+    add("parse_allocs_per_report", double(parseAllocations) / reports.size());
+
+    // Context is already warmed up by the batch benchmark above
+    const auto batchAllocationsBefore = allocationCount.load();
+    Parser::parseBatch(reports, context, [](size_t, const ParseResult &) {});
+    const auto batchAllocations = allocationCount.load() - batchAllocationsBefore;
+    add("batch_allocs_per_report", double(batchAllocations) / reports.size());
+
+    // Rendering of already parsed groups
+    vector<ParseResult> results;
+    for (const auto & report : reports) results.push_back(Parser::parse(report));
+    RenderVisitor visitor;
+    size_t renderedLength = 0;
+    const double renderSeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            for (const auto & result : results)
+                for (const auto & groupInfo : result.groups)
+                    renderedLength += visitor.visit(groupInfo).length();
+    });
+    add("render_groups_per_s", parsedGroups / renderSeconds);
+    add("render_ns_per_group", renderSeconds * 1e9 / parsedGroups);
+
+    // Snapshot of parsed reports is loaded from memory as if it was mapped
+    // from file; scan reads report metadata and wind columns of every report
+    SnapshotWriter snapshotWriter;
+    for (size_t i = 0; i < reports.size(); i++) snapshotWriter.add(reports[i], results[i]);
+    ostringstream snapshotStream;
+    snapshotWriter.write(snapshotStream);
+    const string snapshotData = snapshotStream.str();
+    vector<uint64_t> snapshotBuffer(snapshotData.size() / sizeof(uint64_t) + 1);
+    memcpy(snapshotBuffer.data(), snapshotData.data(), snapshotData.size());
+    const char * snapshot = reinterpret_cast<const char *>(snapshotBuffer.data());
+    string snapshotError;
+    size_t snapshotChecksum = 0;
+    const double loadSeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            snapshotChecksum += SnapshotView::load(snapshot,
+                snapshotData.size(), snapshotError)->reportCount();
+    });
+    const auto snapshotView = SnapshotView::load(snapshot, snapshotData.size(), snapshotError);
+    const double scanSeconds = bestSeconds(options.repeats, [&] {
+        const auto types = snapshotView->column<uint8_t>(SnapshotColumn::REPORT_TYPE);
+        const auto times = snapshotView->column<uint32_t>(SnapshotColumn::REPORT_TIME);
+        const auto gusts = snapshotView->column<float>(SnapshotColumn::WIND_GUST);
+        for (int i = 0; i < options.iterations; i++) {
+            for (size_t j = 0; j < snapshotView->reportCount(); j++) {
+                snapshotChecksum += types[j] + times[j] +
+                    snapshotView->location(j).length();
+            }
+            for (const auto gust : gusts) snapshotChecksum += (gust > 25.0f);
+        }
+    });
+    add("snapshot_bytes_per_report", double(snapshotData.size()) / reports.size());
+    add("snapshot_load_us", loadSeconds * 1e6 / options.iterations);
+    add("snapshot_scan_reports_per_s", parsedReports / scanSeconds);
+
+    // Encoded size with built-in dictionary and with dictionary trained on
+    // the corpus itself; decoding is measured with trained dictionary
+    const auto & builtinDictionary = ReportDictionary::builtin();
+    const auto trainedDictionary = ReportDictionary::train(reports);
+    size_t builtinBytes = 0;
+    for (const auto & report : reports)
+        builtinBytes += ReportCodec(builtinDictionary).encode(report).size();
+    const ReportCodec codec(trainedDictionary);
+    vector<string> encoded(reports.size());
+    const double encodeSeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            for (size_t j = 0; j < reports.size(); j++) {
+                encoded[j].clear();
+                codec.encode(reports[j], encoded[j]);
+            }
+    });
+    size_t trainedBytes = 0;
+    size_t codecMismatches = 0;
+    string decoded;
+    for (size_t j = 0; j < reports.size(); j++) {
+        trainedBytes += encoded[j].size();
+        if (!codec.decode(encoded[j], decoded) || decoded != reports[j]) codecMismatches++;
+    }
+    const double decodeSeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            for (const auto & e : encoded)
+                codec.decode(e, decoded);
+    });
+    const double decodeParseSeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            for (const auto & e : encoded) {
+                codec.decode(e, decoded);
+                Parser::parse(decoded, context);
+            }
+    });
+    vector<string_view> groups;
+    const double decodeGroupsSeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            for (const auto & e : encoded) {
+                codec.decodeGroups(e, groups);
+                Parser::parseGroups(groups, context);
+            }
+    });
+    add("codec_builtin_bytes_per_report", double(builtinBytes) / reports.size());
+    add("codec_trained_bytes_per_report", double(trainedBytes) / reports.size());
+    add("codec_encode_reports_per_s", parsedReports / encodeSeconds);
+    add("codec_decode_reports_per_s", parsedReports / decodeSeconds);
+    add("codec_decode_parse_reports_per_s", parsedReports / decodeParseSeconds);
+    add("codec_groups_parse_reports_per_s", parsedReports / decodeGroupsSeconds);
+
+    // Every report is found in the parse cache after the first pass
+    ParseCache parseCache;
+    size_t cachedGroups = 0;
+    const double cacheSeconds = bestSeconds(options.repeats, [&] {
+        for (int i = 0; i < options.iterations; i++)
+            for (const auto & report : reports)
+                cachedGroups += parseCache.parse(report, context)->groups.size();
+    });
+    const auto cacheStatistics = parseCache.statistics();
+    add("cache_hit_reports_per_s", parsedReports / cacheSeconds);
+    add("cache_bytes_per_report", double(cacheStatistics.bytes) / cacheStatistics.entries);
+
+    size_t rawBytes = 0;
+    for (const auto & report : reports) rawBytes += report.size();
+    cout << corpus.name << ": " << reports.size() << " reports, "
+        << groupsPerPass << " groups, " << renderedLength << " chars rendered, "
+        << "snapshot checksum " << snapshotChecksum << ", "
+        << rawBytes << " bytes encoded to " << builtinBytes << " (built-in dictionary) / "
+        << trainedBytes << " (trained, " << trainedDictionary.size() << " tokens), "
+        << codecMismatches << " round trip mismatches, "
+        << cachedGroups << " cached groups" << endl;
+}
+
+// Parse cost of each group type across all corpora
+static void benchmarkGroupTypes(const vector<Corpus> & corpora,
+    const Options & options,
+    Metrics & metrics)
+{
+    struct GroupSample {
+        string group;
+        ReportPart reportPart;
+        ReportMetadata reportMetadata;
+    };
+    vector<vector<GroupSample>> samples(variant_size_v<Group>);
+    for (const auto & corpus : corpora)
+        for (const auto & report : corpus.reports) {
+            const auto result = Parser::parse(report);
+            for (const auto & groupInfo : result.groups) {
+                const auto & raw = groupInfo.rawString;
+                samples[groupInfo.group.index()].push_back(GroupSample{
+                    raw.substr(0, raw.find(groupDelimiterChar)),
+                    groupInfo.reportPart,
+                    result.reportMetadata});
+            }
+        }
+    for (size_t type = 0; type < samples.size(); type++) {
+        if (samples[type].empty()) continue;
+        size_t recognised = 0;
+        const double seconds = bestSeconds(options.repeats, [&] {
+            for (int i = 0; i < options.iterations; i++)
+                for (const auto & sample : samples[type])
+                    recognised += GroupParser::parse(sample.group,
+                        sample.reportPart,
+                        sample.reportMetadata).index() == type;
+        });
+        const double parsed = double(samples[type].size()) * options.iterations;
+        metrics.emplace_back(string("group.") + groupTypeNames[type] + ".parse_ns",
+            seconds * 1e9 / parsed);
+        metrics.emplace_back(string("group.") + groupTypeNames[type] + ".count",
+            double(samples[type].size()));
+    }
+}
+
+static void printMetrics(const Metrics & metrics) {
+    for (const auto & [name, value] : metrics)
+        cout << "  " << left << setw(48) << name << " " << value << endl;
+}
+
+static bool saveJson(const string & file, const Options & options, const Metrics & metrics) {
+    ofstream output(file);
+    if (!output) return false;
+    output << "{" << endl;
+    output << "  \"metaf_version\": \"" << Version::major << "." << Version::minor <<
+        "." << Version::patch << Version::tag << "\"," << endl;
+    output << "  \"iterations\": " << options.iterations << "," << endl;
+    output << "  \"repeats\": " << options.repeats << "," << endl;
+    output << "  \"metrics\": {" << endl;
+    output << setprecision(10);
+    for (size_t i = 0; i < metrics.size(); i++) {
+        output << "    \"" << metrics[i].first << "\": " << metrics[i].second;
+        output << ((i + 1 < metrics.size()) ? "," : "") << endl;
+    }
+    output << "  }" << endl;
+    output << "}" << endl;
+    return true;
+}
+
+// Reads metrics from the file saved by saveJson(); one metric per line
+static bool loadJson(const string & file, Metrics & metrics) {
+    ifstream input(file);
+    if (!input) return false;
+    bool inMetrics = false;
+    for (string line; getline(input, line); ) {
+        if (line.find("\"metrics\"") != string::npos) { inMetrics = true; continue; }
+        if (!inMetrics) continue;
+        const auto nameBegin = line.find('"');
+        if (nameBegin == string::npos) continue;
+        const auto nameEnd = line.find('"', nameBegin + 1);
+        if (nameEnd == string::npos) continue;
+        const auto colon = line.find(':', nameEnd);
+        if (colon == string::npos) continue;
+        istringstream value(line.substr(colon + 1));
+        double number = 0.0;
+        if (value >> number)
+            metrics.emplace_back(line.substr(nameBegin + 1, nameEnd - nameBegin - 1), number);
+    }
+    return true;
+}
+
+// Prints metrics compared with baseline and returns number of metrics which
+// are worse than baseline by more than tolerance
+static size_t compareWithBaseline(const Metrics & metrics,
+    const Metrics & baseline,
+    double tolerance)
+{
+    static const string countSuffix = ".count";
+    size_t regressions = 0;
+    for (const auto & [name, value] : metrics) {
+        // Group counts only depend on corpus
+        if (name.length() >= countSuffix.length() && name.compare(
+            name.length() - countSuffix.length(), countSuffix.length(), countSuffix) == 0)
+                continue;
+        const auto base = find_if(baseline.begin(), baseline.end(),
+            [&](const auto & metric) { return metric.first == name; });
+        if (base == baseline.end()) continue;
+        // Positive change means better result
+        double change = 0.0;
+        if (base->second != 0.0) {
+            change = (value - base->second) / base->second * 100.0;
+            if (!higherIsBetter(name)) change = -change;
+        } else if (value != 0.0) {
+            change = higherIsBetter(name) ? 100.0 : -100.0;
+        }
+        const bool regression = (change < -tolerance);
+        if (regression) regressions++;
+        ostringstream changeStr;
+        changeStr << showpos << fixed << setprecision(1) << change << "%";
+        cout << "  " << left << setw(48) << name << " " << setw(12) << base->second
+            << " -> " << setw(12) << value << " " << changeStr.str()
+            << (regression ? "  REGRESSION" : "") << endl;
+    }
+    return regressions;
+}
+
+static bool parseOptions(int argc, char ** argv, Options & options) {
+    try {
+        for (int i = 1; i < argc; i++) {
+            const string arg = argv[i];
+            const bool hasValue = (i + 1 < argc);
+            if ((arg == "-i" || arg == "--iterations") && hasValue) {
+                options.iterations = stoi(argv[++i]);
+            } else if ((arg == "-r" || arg == "--repeats") && hasValue) {
+                options.repeats = stoi(argv[++i]);
+            } else if ((arg == "-t" || arg == "--threads") && hasValue) {
+                options.threads = stoul(argv[++i]);
+            } else if ((arg == "-j" || arg == "--json") && hasValue) {
+                options.jsonFile = argv[++i];
+            } else if ((arg == "-b" || arg == "--baseline") && hasValue) {
+                options.baselineFile = argv[++i];
+            } else if (arg == "--tolerance" && hasValue) {
+                options.tolerance = stod(argv[++i]);
+            } else if (!arg.empty() && arg[0] == '-') {
+                return false;
+            } else {
+                options.corpusFiles.push_back(arg);
+            }
+        }
+    } catch (const logic_error &) {
+        // Invalid number in option value
+        return false;
+    }
+    if (options.iterations < 1 || options.repeats < 1) return false;
+    if (options.corpusFiles.empty())
+        options.corpusFiles = {"corpus/icao.txt", "corpus/us.txt", "corpus/malformed.txt"};
+    return true;
+}
+
+int main(int argc, char ** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        cerr << "Usage: metaf_bench [-i iterations] [-r repeats] [-t threads] "
+            "[-j json file] [-b baseline json file] [--tolerance percent] "
+            "[corpus files]" << endl;
+        return 1;
+    }
+
+    vector<Corpus> corpora;
+    for (const auto & file : options.corpusFiles) {
+        Corpus corpus;
+        if (!readCorpus(file, corpus)) {
+            cerr << "No reports found in " << file << endl;
+            return 1;
+        }
+        corpora.push_back(move(corpus));
+    }
+    Corpus all;
+    all.name = "all";
+    for (const auto & corpus : corpora)
+        all.reports.insert(all.reports.end(), corpus.reports.begin(), corpus.reports.end());
+
+    BulkParser bulkParser(options.threads);
+    cout << "metaf " << Version::major << "." << Version::minor << "." << Version::patch
+        << Version::tag << ", " << options.iterations << " iterations, best of "
+        << options.repeats << ", " << bulkParser.threadCount() << " bulk threads" << endl;
+
+    Metrics metrics;
+    for (const auto & corpus : corpora)
+        benchmarkCorpus(corpus, options, bulkParser, metrics);
+    if (corpora.size() > 1) benchmarkCorpus(all, options, bulkParser, metrics);
+    benchmarkGroupTypes(corpora, options, metrics);
+    printMetrics(metrics);
+
+    if (!options.jsonFile.empty() && !saveJson(options.jsonFile, options, metrics)) {
+        cerr << "Unable to write " << options.jsonFile << endl;
+        return 1;
+    }
+    if (!options.baselineFile.empty()) {
+        Metrics baseline;
+        if (!loadJson(options.baselineFile, baseline)) {
+            cerr << "Unable to read " << options.baselineFile << endl;
+            return 1;
+        }
+        cout << "compared with " << options.baselineFile << " (tolerance "
+            << options.tolerance << "%):" << endl;
+        const auto regressions = compareWithBaseline(metrics, baseline, options.tolerance);
+        cout << regressions << " regression(s)" << endl;
+        if (regressions) return 2;
+    }
+    return 0;
+}
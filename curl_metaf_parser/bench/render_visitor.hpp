@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Group rendering shared by benchmarks                                                     //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RENDER_VISITOR_HPP
+#define RENDER_VISITOR_HPP
+
+#include "METAF.hpp"
+#include <string>
+
+// Renders groups the same way as the visitor in curl_metaf_parser.cpp
+class RenderVisitor : public metaf::Visitor<std::string> {
+    std::string visitKeywordGroup(const metaf::KeywordGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Keyword: " + raw;
+    }
+    std::string visitLocationGroup(const metaf::LocationGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "ICAO location: " + raw;
+    }
+    std::string visitReportTimeGroup(const metaf::ReportTimeGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Report Release Time: " + raw;
+    }
+    std::string visitTrendGroup(const metaf::TrendGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Trend Header: " + raw;
+    }
+    std::string visitWindGroup(const metaf::WindGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Wind: " + raw;
+    }
+    std::string visitVisibilityGroup(const metaf::VisibilityGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Visibility: " + raw;
+    }
+    std::string visitCloudGroup(const metaf::CloudGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Cloud Data: " + raw;
+    }
+    std::string visitWeatherGroup(const metaf::WeatherGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Weather Phenomena: " + raw;
+    }
+    std::string visitTemperatureGroup(const metaf::TemperatureGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Temperature and Dew Point: " + raw;
+    }
+    std::string visitPressureGroup(const metaf::PressureGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Pressure: " + raw;
+    }
+    std::string visitRunwayStateGroup(const metaf::RunwayStateGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "State of Runway: " + raw;
+    }
+    std::string visitSeaSurfaceGroup(const metaf::SeaSurfaceGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Sea Surface: " + raw;
+    }
+    std::string visitMinMaxTemperatureGroup(const metaf::MinMaxTemperatureGroup &,
+        metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Min/Max Temperature: " + raw;
+    }
+    std::string visitPrecipitationGroup(const metaf::PrecipitationGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Precipitation: " + raw;
+    }
+    std::string visitLayerForecastGroup(const metaf::LayerForecastGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Atmospheric Layer Forecast: " + raw;
+    }
+    std::string visitPressureTendencyGroup(const metaf::PressureTendencyGroup &,
+        metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Pressure Tendency: " + raw;
+    }
+    std::string visitCloudTypesGroup(const metaf::CloudTypesGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Cloud Types: " + raw;
+    }
+    std::string visitLowMidHighCloudGroup(const metaf::LowMidHighCloudGroup &,
+        metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Low, middle, and high cloud layers: " + raw;
+    }
+    std::string visitLightningGroup(const metaf::LightningGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Lightning data: " + raw;
+    }
+    std::string visitVicinityGroup(const metaf::VicinityGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Events in vicinity: " + raw;
+    }
+    std::string visitMiscGroup(const metaf::MiscGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Miscellaneous Data: " + raw;
+    }
+    std::string visitUnknownGroup(const metaf::UnknownGroup &, metaf::ReportPart,
+        const std::string & raw) override
+    {
+        return "Not recognised by parser: " + raw;
+    }
+};
+
+#endif //#ifndef RENDER_VISITOR_HPP
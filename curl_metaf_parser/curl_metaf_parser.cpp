@@ -11,10 +11,20 @@
 #define CURL_STATICLIB
 
 #include "METAF.hpp"
+#include "metaf_snapshot.hpp"
 #include <iostream>
 #include <cstring>
 #include <sstream>
+#include <fstream>
+#include <csignal>
+#include <chrono>
 #include "curl\curl.h"
+#include "awc_fetch.hpp"
+#include "awc_reports.hpp"
+#include "awc_briefing.hpp"
+#include "awc_archive.hpp"
+#include "awc_history.hpp"
+#include "awc_daemon.hpp"
 
 #ifdef _DEBUG
 
@@ -34,19 +44,6 @@ using namespace metaf;
 
 // --------------------------------------------------------------------------------------------
 
-char ap_departure[5] = "UKOO";
-char ap_arriving[5] = "UKBB";
-char search_radius[3] = "50";
-char hours_before_now[3] = "2";
-
-//---------------------------------------------------------------------------------------------
-
-size_t write_data(char* ptr, size_t size, size_t nmemb, FILE* data)
-{
-    return fwrite(ptr, size, nmemb, data);
-}
-//---------------------------------------------------------------------------------------------
-
 // Test function for flightpath data input:
 
 int test_input(void);
@@ -314,34 +311,202 @@ class MyVisitor : public Visitor<string> {
 };
 
 // ===================================================================================================
-// |                               MAIN function start                                               |
+// |                               Route briefing output                                             |
+// ===================================================================================================
+
+// Prints the report decoded group by group, or notice if the station has no report of this type
+
+void print_decoded(const char* type, const string& station, const awc::StationReport* report)
+{
+    if (!report)
+    {
+        cout << "\nNo " << type << " for " << station << endl;
+        return;
+    }
+    cout << "\nParsing report: " << report->rawText << endl;
+    cout << "Parse error: ";
+    cout << errorMessage(report->result->reportMetadata.error) << "\n";
+    cout << "Detected report type: ";
+    cout << reportTypeMessage(report->result->reportMetadata.type) << "\n";
+    cout << report->result->groups.size() << " groups parsed\n";
+    MyVisitor visitor;
+    for (const auto& groupInfo : report->result->groups) {
+        cout << visitor.visit(groupInfo) << "\n";
+    }
+}
+
+// ===================================================================================================
+// |                               Daemon mode                                                       |
 // ===================================================================================================
 
-int main(void)
+// Polls routes and stations listed in the configuration file until <Ctrl+C>, latest reports are
+// printed to stdout when changed and stored to the state file (see awc_daemon.hpp for the format)
+
+void stop_daemon(int)
 {
+    awc::Daemon::requestStop();
+}
+
+int run_daemon(const char* config_filename, const string* server_url)
+{
+    ifstream config_file(config_filename);
+    if (!config_file)
+    {
+        cerr << "Cannot open configuration file " << config_filename << endl;
+        return -1;
+    }
+    string error;
+    auto config = awc::DaemonConfig::load(config_file, error);
+    if (!config.has_value())
+    {
+        cerr << config_filename << ": " << error << endl;
+        return -1;
+    }
+    if (server_url)
+        config->serverUrl = *server_url;
 
-    // Define and open local files for METAR and TAF ------------------------------------------------
+    signal(SIGINT, stop_daemon);
+    signal(SIGTERM, stop_daemon);
+
+    awc::Daemon daemon(std::move(*config));
+    daemon.run();
+
+    const auto cache = daemon.parseCache().statistics();
+    cerr << "Parse cache: " << cache.hits << " hits, " << cache.misses << " misses, "
+        << cache.evictions << " evictions, " << cache.entries << " reports cached" << endl;
+    return 0;
+}
+
+// ===================================================================================================
+// |                               Archive ingestion                                                 |
+// ===================================================================================================
+
+// Parses all reports of archive file (saved CSV response or one raw report per line) on all CPU
+// cores and stores them to snapshot file (see metaf_snapshot.hpp)
+
+int run_ingest(const char* archive_filename, const char* snapshot_filename)
+{
+    awc::ArchiveReader archive;
+    string error;
+    if (!archive.open(archive_filename, error))
+    {
+        cerr << error << endl;
+        return -1;
+    }
+    const auto start = chrono::steady_clock::now();
+    SnapshotWriter snapshot;
+    metaf::BulkParser bulk_parser;
+    archive.parse(bulk_parser, [&](string_view report, const ParseResult& result) {
+        snapshot.add(report, result);
+    });
+    ofstream snapshot_file(snapshot_filename, ios::binary);
+    if (!snapshot.write(snapshot_file))
+    {
+        cerr << "Unable to write " << snapshot_filename << endl;
+        return -1;
+    }
+    const chrono::duration<double> seconds = chrono::steady_clock::now() - start;
+    cout << snapshot.reportCount() << " reports (" << archive.size() << " bytes, "
+        << (archive.format() == awc::ArchiveReader::Format::CSV ? "CSV" : "one report per line")
+        << ") ingested in " << seconds.count() << " s" << endl;
+    return 0;
+}
+
+// ===================================================================================================
+// |                               Report history                                                    |
+// ===================================================================================================
+
+// Prints reports of the station received during the last hours (by report time) from the history
+// which is stored by every run of the app (files/history) or by the daemon
+
+int run_history(const char* history_directory, const char* station_id, const char* hours_text)
+{
+    const int hours = atoi(hours_text);
+    if (hours <= 0)
+    {
+        cerr << "Invalid number of hours " << hours_text << endl;
+        return -1;
+    }
+    awc::ReportHistory history;
+    string error;
+    if (!history.open(history_directory, error))
+    {
+        cerr << error << endl;
+        return -1;
+    }
+    const auto reports = history.lastHours(station_id, static_cast<unsigned int>(hours));
+    for (const auto& report : reports)
+        cout << (report.isTaf ? "TAF   " : "METAR ") << report.rawText << endl;
+    cout << reports.size() << " reports of " << station_id << " in the last " << hours << " hours" << endl;
+    return 0;
+}
+
+// ===================================================================================================
+// |                               MAIN function start                                               |
+// ===================================================================================================
+
+int main(int argc, char* argv[])
+{
+    // Command line: curl_metaf_parser [--server <dataserver URL>] [--daemon <configuration file>] -----
+    //                                 [--ingest <archive file> <snapshot file>]
+    //                                 [--history <ICAO> <hours>]
+    // --server redirects requests e.g. to local stand-in dataserver (bench/awc_dataserver)
+    // --daemon runs non-interactive mode
+    // --ingest converts archive of reports to snapshot and exits
+    // --history prints stored reports of the station for the last hours and exits
+
+    string server_url = awc::dataserverUrl;
+    bool server_url_given = false;
+    const char* daemon_config = nullptr;
+    const string history_directory = "files/history";
+    for (int arg = 1; arg < argc; arg++) {
+        const string option = argv[arg];
+        if (option == "--server" && arg + 1 < argc) {
+            server_url = argv[++arg];
+            server_url_given = true;
+        }
+        else if (option == "--daemon" && arg + 1 < argc) {
+            daemon_config = argv[++arg];
+        }
+        else if (option == "--ingest" && arg + 2 < argc) {
+            return run_ingest(argv[arg + 1], argv[arg + 2]);
+        }
+        else if (option == "--history" && arg + 2 < argc) {
+            return run_history(history_directory.c_str(), argv[arg + 1], argv[arg + 2]);
+        }
+        else {
+            cerr << "Usage: " << argv[0] << " [--server <dataserver URL>] [--daemon <configuration file>]" << endl;
+            cerr << "       " << argv[0] << " --ingest <archive file> <snapshot file>" << endl;
+            cerr << "       " << argv[0] << " --history <ICAO> <hours>" << endl;
+            return -1;
+        }
+    }
+    if (daemon_config)
+        return run_daemon(daemon_config, server_url_given ? &server_url : nullptr);
+
+    // Define and open local files for METAR and TAF (copies of received data, written in background) ---
 
     const string header_filename_metars = "files/metars.txt";
     const string body_filename_metars = "files/metars.csv";
     const string header_filename_tafs = "files/tafs.txt";
     const string body_filename_tafs = "files/tafs.csv";
     const string filename_metafs = "files/metafs.txt";
+    const string filename_snapshot = "files/reports.snapshot";
 
-    FILE* header_file_metars = fopen(header_filename_metars.c_str(), "w");
-    if (header_file_metars == NULL)
+    awc::AsyncFileWriter header_file_metars(header_filename_metars);
+    if (!header_file_metars.isOpen())
         return -1;
 
-    FILE* body_file_metars = fopen(body_filename_metars.c_str(), "w");
-    if (body_file_metars == NULL)
+    awc::AsyncFileWriter body_file_metars(body_filename_metars);
+    if (!body_file_metars.isOpen())
         return -1;
 
-    FILE* header_file_tafs = fopen(header_filename_tafs.c_str(), "w");
-    if (header_file_tafs == NULL)
+    awc::AsyncFileWriter header_file_tafs(header_filename_tafs);
+    if (!header_file_tafs.isOpen())
         return -1;
 
-    FILE* body_file_tafs = fopen(body_filename_tafs.c_str(), "w");
-    if (body_file_tafs == NULL)
+    awc::AsyncFileWriter body_file_tafs(body_filename_tafs);
+    if (!body_file_tafs.isOpen())
         return -1;
 
     // Query data input ---------------------------------------------------------------------------
@@ -349,14 +514,21 @@ int main(void)
     system("cls");
     std::cout << "\nWelcome Sir." << std::endl;
     std::cout << "\nPlease input flight path data or press <Ctrl+C> to exit: " << std::endl;
-    std::cout << "\nDeparture AP ICAO: ";
-    std::cin >> ap_departure;
-    std::cout << "Arriving AP ICAO: ";
-    std::cin >> ap_arriving;
+    std::cout << "\nRoute (departure, alternates, destination ICAO separated by spaces): ";
+    string route_text;
+    getline(std::cin, route_text);
+    const vector<string> flight_path = awc::parseWaypoints(route_text);
+    unsigned int radius = 50;
+    unsigned int hours = 2;
     std::cout << "Radius search (nm): ";
-    std::cin >> search_radius;
+    std::cin >> radius;
     std::cout << "Hours before now: ";
-    std::cin >> hours_before_now;
+    std::cin >> hours;
+    if (flight_path.empty() || !std::cin)
+    {
+        cerr << "Invalid flight path data" << endl;
+        return -1;
+    }
 
     // Indicator bar ------------------------------------------------------------------------------
 
@@ -370,70 +542,52 @@ int main(void)
 
     // Module to receive data files from AWC =============================================================================
 
-    CURL* curl_handle = curl_easy_init();
-    if (curl_handle)
-    {
-        // METARS part -------------------------------------------------------------------------------------------------------------
-
-        char url_metars_01[] = "https://aviationweather.gov/adds/dataserver_current/httpparam?dataSource=metars&requestType=retrieve&format=csv&flightPath=";
-        char url_metars_02[] = "&hoursBeforeNow=";
-
-        stringstream url_metars;
-        url_metars << url_metars_01 << search_radius << ";" << ap_departure << ";" << ap_arriving << url_metars_02 << hours_before_now;
-        string str_url_metars = url_metars.str();
-
-        // debug block
-        // test_input();
-        //cout << str_url_metars << endl; //debug url
-
-        curl_easy_setopt(curl_handle, CURLOPT_SSL_VERIFYPEER, FALSE);
-        curl_easy_setopt(curl_handle, CURLOPT_URL, str_url_metars.c_str());
-
-        // save METARS file.csv
-        curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, body_file_metars);
-        curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, write_data);
-
-        // save header METARS file.txt
-        curl_easy_setopt(curl_handle, CURLOPT_WRITEHEADER, header_file_metars);
-
-        CURLcode res_metars = curl_easy_perform(curl_handle);
-        if (res_metars != CURLE_OK)
-            cout << "curl_easy_perform() failed: %s\n" << curl_easy_strerror(res_metars) << endl;
+    // METARS and TAFS are requested at once, so the flightpath data arrive in the time of the slower request
 
-        // TAFS part --------------------------------------------------------------------------------------------------------------
+    const string url_metars = awc::flightPathUrl("metars", flight_path, radius, hours, server_url);
+    const string url_tafs = awc::flightPathUrl("tafs", flight_path, radius, hours, server_url);
 
-        char url_tafs_01[] = "https://aviationweather.gov/adds/dataserver_current/httpparam?dataSource=tafs&requestType=retrieve&format=csv&flightPath=";
-        char url_tafs_02[] = "&hoursBeforeNow=";
+    // debug block
+    // test_input();
+    // cout << url_metars << endl << url_tafs << endl; //debug url
 
-        stringstream url_tafs;
-        url_tafs << url_tafs_01 << search_radius << ";" << ap_departure << ";" << ap_arriving << url_tafs_02 << hours_before_now;
-        string str_url_tafs = url_tafs.str();
+    // Reports the result of each request as soon as it is finished
+    auto report_fetch = [](const awc::ReportQuery& query, const awc::FetchResult& result) {
+        if (result.code != CURLE_OK)
+            cout << "Request failed: " << result.error << endl;
+        else if (!result.isOk())
+            cout << "Request failed: HTTP status " << result.httpStatus << endl;
+        for (const auto& error : query.errors())
+            cout << "Dataserver error: " << error << endl;
+        // cout << query.url() << " " << result.seconds << " s, " << result.wireBytes << " bytes received, " << result.decodedBytes << " bytes decoded" << endl; // debug
+    };
 
-        // debug block
-        // test_input();
-        // cout << str_url_tafs << endl; //debug url
+    // ----- METARS and TAFS queries; reports of all corridor stations are decoded in parallel when  -----
+    // ----- response is complete and are kept between requests, unchanged responses (304) are not  -----
+    // ----- downloaded again                                                                       -----
 
-        curl_easy_setopt(curl_handle, CURLOPT_SSL_VERIFYPEER, FALSE);
-        curl_easy_setopt(curl_handle, CURLOPT_URL, str_url_tafs.c_str());
+    metaf::BulkParser bulk_parser;
+    awc::ReportQuery metars(url_metars, &bulk_parser);
+    awc::ReportQuery tafs(url_tafs, &bulk_parser);
 
-        // save TAFS file.csv
-        curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, body_file_tafs);
-        curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, write_data);
+    awc::FetchEngine fetch_engine;
 
-        // save header TAFS file.txt
-        curl_easy_setopt(curl_handle, CURLOPT_WRITEHEADER, header_file_tafs);
+    // parse METARS while receiving, save copies to METARS file.csv and header METARS file.txt
+    awc::FetchRequest request_metars = metars.request(report_fetch);
+    request_metars.onBody = [&, parse = request_metars.onBody](const char* data, size_t size) { parse(data, size); body_file_metars.write(data, size); };
+    request_metars.onHeader = [&](const char* data, size_t size) { header_file_metars.write(data, size); };
+    fetch_engine.add(request_metars);
 
-        CURLcode res_tafs = curl_easy_perform(curl_handle);
-        if (res_tafs != CURLE_OK)
-            cout << "curl_easy_perform() failed: %s\n" << curl_easy_strerror(res_tafs) << endl;
+    // parse TAFS while receiving, save copies to TAFS file.csv and header TAFS file.txt
+    awc::FetchRequest request_tafs = tafs.request(report_fetch);
+    request_tafs.onBody = [&, parse = request_tafs.onBody](const char* data, size_t size) { parse(data, size); body_file_tafs.write(data, size); };
+    request_tafs.onHeader = [&](const char* data, size_t size) { header_file_tafs.write(data, size); };
+    fetch_engine.add(request_tafs);
 
-        curl_easy_cleanup(curl_handle);
-    }
+    fetch_engine.run();
 
-    fclose(header_file_metars);
-    fclose(body_file_metars);
-    fclose(header_file_tafs);
-    fclose(body_file_tafs);
+    // Reports grouped by station: waypoints in route order, then other stations within the corridor
+    const awc::RouteBriefing briefing(flight_path, metars, tafs);
 
     cout << "Done!" << "\nFlightpath weather data were stored in subfolder </files> in the files: " << body_filename_metars << ", " << body_filename_tafs << endl;
     cout << endl;
@@ -441,245 +595,80 @@ int main(void)
     cout << "\nSo ... \n";
 
 
- // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!  DATA extracting from file receiving  !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
- 
- // === METAR section =====================================================================================
-
-    int i = 0;
-    char str_csv_metar1[50000];
-    char str_txt_metar1[300];
+ // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!  DATA extracted from received records  !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
-    FILE* fp_csv_m1 = fopen("files/metars.csv", "r");   // Path can to be changed for release ver.
     FILE* fp_txt_m1 = fopen("files/metaf.txt", "w");    // Path can to be changed for release ver.
-    if (fp_csv_m1 != NULL) {
-        while ((str_csv_metar1[i] = getc(fp_csv_m1)) != EOF) i++;
-        str_csv_metar1[i] = '\0';
-    }
-
-    //   cout << str_csv_metar1; // debug
-
-    //  ----- str_m - METARS string from file request -----
-
-    string str_m = string(str_csv_metar1);
-    int a;
-
-    // METAR for departure airport ------------------------------------------------------------------------
-
-    stringstream ap_departure_metar_tmp;
-    ap_departure_metar_tmp << "," << ap_departure << ",";
-    string ap_departure_metar_tmpl = ap_departure_metar_tmp.str();
-    string ap_departure_metar_orig = ap_departure;
-
-    i = str_m.find(ap_departure_metar_tmpl);
-
-    //   cout << i; // debug
 
-    string beginStr_m_dep = str_m.substr(0, i);
+    // Latest METAR and TAF of every station (raw text of TAF starts with TAF) ---------------------------
 
-    //   cout << beginStr_m_dep << endl; // debug
-
-    i = beginStr_m_dep.find(ap_departure_metar_orig);
-    string endStr_m_dep = str_m.substr(i, beginStr_m_dep.length() - i);
-    cout << "METAR " << endStr_m_dep << endl;
-    if (endStr_m_dep.empty())
+    for (size_t i = 0; i < briefing.stations().size(); i++)
     {
-        cout << "app" << endl;
-    }
-
-    // cout << str_txt_metar1 << endl; // debug
-
-    fputs(endStr_m_dep.c_str(), fp_txt_m1);
-    fputs("\n", fp_txt_m1);
-
-    // METAR for arriving airport ------------------------------------------------------------------------
-
-    stringstream ap_arriving_metar_tmp;
-    ap_arriving_metar_tmp << "," << ap_arriving << ",";
-    string ap_arriving_metar_tmpl = ap_arriving_metar_tmp.str();
-    string ap_arriving_metar_orig = ap_arriving;
-
-    i = str_m.find(ap_arriving_metar_tmpl);
-
-    //   cout << i; // debug
-
-    string beginStr_m_arr = str_m.substr(0, i);
-
-    //   cout << beginStr_m_arr << endl; // debug
-
-    i = beginStr_m_arr.find(ap_arriving_metar_orig);
-    string endStr_m_arr = str_m.substr(i, beginStr_m_arr.length() - i);
-    cout << "METAR " << endStr_m_arr << endl;
-    if (endStr_m_arr.empty())
+        const awc::StationBriefing& station = briefing.stations()[i];
+        if (i == 0)
+            cout << "\nRoute waypoints:\n";
+        if (i == briefing.waypointCount())
+            cout << "\nOther stations within " << radius << " nm of flight path:\n";
+
+        const awc::StationReport* metar = station.latestMetar();
+        const awc::StationReport* taf = station.latestTaf();
+        cout << "METAR " << (metar ? metar->rawText : station.stationId + " no report") << endl;
+        cout << (taf ? taf->rawText : "TAF " + station.stationId + " no report") << endl;
+        if (metar)
+        {
+            fputs(metar->rawText.c_str(), fp_txt_m1);
+            fputs("\n", fp_txt_m1);
+        }
+        if (taf)
+        {
+            fputs(taf->rawText.c_str(), fp_txt_m1);
+            fputs("\n", fp_txt_m1);
+        }
+    }
+
+    // Snapshot of all received reports, may be reloaded without parsing (see metaf_snapshot.hpp) -------
+
+    SnapshotWriter snapshot;
+    for (const auto* query : { &metars, &tafs })
+        for (const auto& report : query->reports())
+            snapshot.add(report.rawText, *report.result);
+    ofstream snapshot_file(filename_snapshot, ios::binary);
+    if (!snapshot.write(snapshot_file))
+        cout << "Unable to write " << filename_snapshot << endl;
+
+    // History of all received reports is kept between runs (files/*.csv are overwritten) -------------
+
+    awc::ReportHistory history;
+    string history_error;
+    size_t new_reports = 0;
+    if (history.open(history_directory, history_error))
     {
-        cout << "app" << endl;
-    }
-
-    // cout << str_txt_metar1 << endl; // debug
-
-    fputs(endStr_m_arr.c_str(), fp_txt_m1);
-    fputs("\n", fp_txt_m1);
-
-
-//== TAF section ========================================================================================
-
-    i = 0;
-    char str_csv_taf1[300000];
-    
-    FILE* fp_csv_t1 = fopen("files/tafs.csv", "r");  // Path can to be changed for release ver.
-
-    if (fp_csv_t1 != NULL) {
-        while ((str_csv_taf1[i] = getc(fp_csv_t1)) != EOF) i++;
-        str_csv_taf1[i] = '\0';
+        new_reports += history.append(metars, false);
+        new_reports += history.append(tafs, true);
     }
-
-    //   cout << str_csv_taf1; // debug
-
-    // ----- str_t - TAFS string from file after request  ------
-
-    string str_t = string(str_csv_taf1);
-
-    // cout << str_t; // debug
-    // system("pause"); // debug
-
-    
-    // TAF for departure airport ------------------------------------------------------------------------
-
-    stringstream ap_departure_taf_tmp;
-    ap_departure_taf_tmp << "," << ap_departure << ",";
-    string ap_departure_taf_tmpl = ap_departure_taf_tmp.str();
-    string ap_departure_taf_orig = ap_departure;
-
-    /*  debug block
-        cout << ap_departure << " " << ap_departure_taf_tmpl << " " << ap_departure_taf_orig << endl;
-        system("pause");
-        // end debug block
-    */
-
-    i = str_t.find(ap_departure_taf_tmpl);
-
-    //   cout << i; // debug
-
-    string beginStr_t_dep = str_t.substr(0, i);
-
-    //   cout << beginStr_t_dep << endl; // debug
-
-    i = beginStr_t_dep.find(ap_departure_taf_orig);
-
-    //   cout << i; // debug
-
-    string endStr_t_dep = str_t.substr(i, beginStr_t_dep.length() - i);
-    cout << "TAF " << endStr_t_dep << endl;
-
-    fputs("TAF ", fp_txt_m1);
-    fputs(endStr_t_dep.c_str(), fp_txt_m1);
-    fputs("\n", fp_txt_m1);
-
-    // TAF for arriving airport ------------------------------------------------------------------------
-
-    stringstream ap_arriving_taf_tmp;
-    ap_arriving_taf_tmp << "," << ap_arriving << ",";
-    string ap_arriving_taf_tmpl = ap_arriving_taf_tmp.str();
-    string ap_arriving_taf_orig = ap_arriving;
-
-    /*  debug block
-        cout << ap_arriving << " " << ap_arriving_taf_tmpl << " " << ap_arriving_taf_orig << endl;
-        system("pause");
-        // end debug block
-    */
-
-    i = str_t.find(ap_arriving_taf_tmpl);
-
-    // cout << i; //debug
-    // system("pause");  //debug
-
-    string beginStr_t_arr = str_t.substr(0, i);
-
-    // cout << beginStr_t_arr << endl;  //debug 
-
-    i = beginStr_t_arr.find(ap_arriving_taf_orig); 
-
-    // cout << i;  //debug
-    // system("pause");  //debug
-
-    string endStr_t_arr = str_t.substr(i, beginStr_t_arr.length() - i);
-    cout << "TAF " << endStr_t_arr << endl;
-    
-    // system("pause");  //debug
-
-    fputs("TAF ", fp_txt_m1);
-    fputs(endStr_t_arr.c_str(), fp_txt_m1);
-    fputs("\n", fp_txt_m1);
+    if (!history_error.empty() || !history.flush(history_error))
+        cout << "Unable to store history: " << history_error << endl;
 
     system("pause"); //debug
 
  //== Parsing section =====================================================================================
 
-    // Departure airport METAR report --------------------------------------------------------------------
+    // Latest METAR and TAF of every waypoint ------------------------------------------------------------
 
-    cout << "\nParsing report: " << endStr_m_dep << endl;
-    const auto result1 = Parser::parse(endStr_m_dep.c_str());
-    cout << "Parse error: ";
-    cout << errorMessage(result1.reportMetadata.error) << "\n";
-    cout << "Detected report type: ";
-    cout << reportTypeMessage(result1.reportMetadata.type) << "\n";
-    cout << result1.groups.size() << " groups parsed\n";
-    MyVisitor visitor1;
-    for (const auto groupInfo : result1.groups) {
-        cout << visitor1.visit(groupInfo) << "\n";
-    }
-    system("pause");
-
-    // Departure airport TAF report --------------------------------------------------------------------
-
-    cout << "\nParsing report: " << endStr_t_dep.c_str() << "\n";
-    const auto result2 = Parser::parse(endStr_t_dep.c_str());
-    cout << "Parse error: ";
-    cout << errorMessage(result2.reportMetadata.error) << "\n";
-    cout << "Detected report type: ";
-    cout << reportTypeMessage(result2.reportMetadata.type) << "\n";
-    cout << result2.groups.size() << " groups parsed\n";
-    MyVisitor visitor2;
-    for (const auto groupInfo : result2.groups) {
-        cout << visitor2.visit(groupInfo) << "\n";
-    }
-    system("pause");
-
-    // Arriving airport METAR report --------------------------------------------------------------------
-
-    cout << "\nParsing report: " << endStr_m_arr.c_str() << "\n";
-    const auto result3 = Parser::parse(endStr_m_arr.c_str());
-    cout << "Parse error: ";
-    cout << errorMessage(result3.reportMetadata.error) << "\n";
-    cout << "Detected report type: ";
-    cout << reportTypeMessage(result3.reportMetadata.type) << "\n";
-    cout << result3.groups.size() << " groups parsed\n";
-    MyVisitor visitor3;
-    for (const auto groupInfo : result3.groups) {
-        cout << visitor3.visit(groupInfo) << "\n";
-    }
-    system("pause");
-
-    // Arriving airport TAF report --------------------------------------------------------------------
-
-    cout << "\nParsing report: " << endStr_t_arr.c_str() << "\n";
-    const auto result4 = Parser::parse(endStr_t_arr.c_str());
-    cout << "Parse error: ";
-    cout << errorMessage(result4.reportMetadata.error) << "\n";
-    cout << "Detected report type: ";
-    cout << reportTypeMessage(result4.reportMetadata.type) << "\n";
-    cout << result4.groups.size() << " groups parsed\n";
-    MyVisitor visitor4;
-    for (const auto groupInfo : result4.groups) {
-        cout << visitor4.visit(groupInfo) << "\n";
+    for (const auto& station : briefing.stations())
+    {
+        if (!station.waypoint.has_value())
+            break;
+        print_decoded("METAR", station.stationId, station.latestMetar());
+        print_decoded("TAF", station.stationId, station.latestTaf());
+        system("pause");
     }
-    system("pause");
 
 
     fclose(fp_txt_m1);
-    fclose(fp_csv_m1);
-    fclose(fp_csv_t1);
 
-    cout << "\nMERARS and TAFS for departure and arriving airports were stored in the file: " << filename_metafs << endl;
+    cout << "\nMERARS and TAFS for route stations were stored in the file: " << filename_metafs << endl;
+    cout << "All received reports were stored in the snapshot file: " << filename_snapshot << endl;
+    cout << new_reports << " new reports were added to the history in: " << history_directory << endl;
     cout << "\nBye, Cap!\n\n";
     system("pause");
     return 0;
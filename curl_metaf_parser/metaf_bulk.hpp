@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Multi-threaded bulk parser for large sets of METAR and TAF reports                       //
+//                                                                                            //
+//   Reports are split into chunks which are distributed among worker threads; a worker       //
+//   which runs out of chunks steals them from other workers. Each worker parses with its     //
+//   own ParseContext. Results are stored in the same order as the input reports.             //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef METAF_BULK_HPP
+#define METAF_BULK_HPP
+
+#include "METAF.hpp"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace metaf {
+
+// Parser is reentrant: it has no mutable static data, and function-local
+// statics as well as missingMetadata are constant; therefore any number
+// of threads may run Parser::parse concurrently with separate contexts.
+// Jobs of BulkParser run one at a time: concurrent calls of run() or
+// parse() wait until the previous job is finished.
+class BulkParser {
+public:
+	// Zero thread count means one thread per hardware thread
+	inline explicit BulkParser(unsigned int threadCount = 0);
+	inline ~BulkParser();
+	BulkParser(const BulkParser &) = delete;
+	BulkParser & operator=(const BulkParser &) = delete;
+
+	unsigned int threadCount() const {
+		return static_cast<unsigned int>(workers.size());
+	}
+
+	// Parses all reports; result[i] corresponds to i-th report in range.
+	// Reports may be any range of strings or string views.
+	template <typename Reports>
+	std::vector<ParseResult> parse(const Reports & reports,
+		size_t groupLimit = 200)
+	{
+		std::vector<std::string_view> views;
+		for (const auto & report : reports) views.push_back(report);
+		std::vector<ParseResult> results(views.size());
+		run(views.size(), [&](std::size_t index, ParseContext & context) {
+			results[index] = Parser::parse(views[index], context, groupLimit);
+		});
+		return results;
+	}
+
+	// Runs task(index, context) for every index from 0 to count - 1,
+	// context is the scratch context of the thread which runs the task.
+	// If tasks throw, the first exception is rethrown when all chunks are
+	// done; the rest of the chunk which threw is skipped.
+	inline void run(std::size_t count,
+		const std::function<void(std::size_t, ParseContext &)> & task);
+
+private:
+	using Task = std::function<void(std::size_t, ParseContext &)>;
+
+	// Chunk refers to its task: a worker may still be looking for chunks
+	// of the finished job when the next job begins
+	struct Chunk {
+		std::size_t begin;
+		std::size_t end;
+		const Task * task;
+	};
+
+	struct Worker {
+		std::mutex mutex;
+		std::deque<Chunk> chunks;
+		ParseContext context;
+		std::thread thread;
+	};
+
+	inline void workerLoop(std::size_t workerIndex);
+	inline bool popChunk(std::size_t workerIndex, Chunk & chunk);
+	inline bool stealChunk(std::size_t workerIndex, Chunk & chunk);
+
+	// Reports per chunk; small enough to balance load between threads,
+	// large enough to keep locking overhead low
+	static const inline std::size_t chunkSize = 32;
+
+	std::vector<std::unique_ptr<Worker>> workers;
+
+	// Held by run() for the whole job
+	std::mutex runMutex;
+	std::mutex jobMutex;
+	std::condition_variable jobStarted;
+	std::condition_variable jobFinished;
+	std::size_t jobGeneration = 0;
+	std::size_t chunksLeft = 0;
+	std::exception_ptr jobError;
+	bool stopping = false;
+};
+
+BulkParser::BulkParser(unsigned int threadCount) {
+	if (!threadCount) threadCount = std::thread::hardware_concurrency();
+	if (!threadCount) threadCount = 1;
+	for (auto i = 0u; i < threadCount; i++)
+		workers.push_back(std::make_unique<Worker>());
+	for (auto i = 0u; i < threadCount; i++)
+		workers[i]->thread = std::thread(&BulkParser::workerLoop, this, i);
+}
+
+BulkParser::~BulkParser() {
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		stopping = true;
+	}
+	jobStarted.notify_all();
+	for (auto & worker : workers) worker->thread.join();
+}
+
+void BulkParser::run(std::size_t count,
+	const std::function<void(std::size_t, ParseContext &)> & task)
+{
+	if (!count) return;
+	std::lock_guard<std::mutex> runLock(runMutex);
+	std::unique_lock<std::mutex> lock(jobMutex);
+	chunksLeft = 0;
+	jobError = nullptr;
+	// Initial distribution is round-robin; imbalance is fixed by stealing
+	for (std::size_t begin = 0; begin < count; begin += chunkSize) {
+		const auto end = (count - begin > chunkSize) ? begin + chunkSize : count;
+		auto & worker = *workers[chunksLeft % workers.size()];
+		std::lock_guard<std::mutex> workerLock(worker.mutex);
+		worker.chunks.push_back(Chunk{begin, end, &task});
+		chunksLeft++;
+	}
+	jobGeneration++;
+	jobStarted.notify_all();
+	jobFinished.wait(lock, [this]{ return !chunksLeft; });
+	if (jobError) std::rethrow_exception(std::exchange(jobError, nullptr));
+}
+
+void BulkParser::workerLoop(std::size_t workerIndex) {
+	std::size_t seenGeneration = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(jobMutex);
+			jobStarted.wait(lock, [&]{
+				return (stopping || jobGeneration != seenGeneration);
+			});
+			if (stopping) return;
+			seenGeneration = jobGeneration;
+		}
+		Chunk chunk;
+		std::size_t chunksDone = 0;
+		std::exception_ptr error;
+		while (popChunk(workerIndex, chunk) || stealChunk(workerIndex, chunk)) {
+			// Exception must not leave the thread, it is passed to run()
+			try {
+				for (auto i = chunk.begin; i < chunk.end; i++)
+					(*chunk.task)(i, workers[workerIndex]->context);
+			} catch (...) {
+				if (!error) error = std::current_exception();
+			}
+			chunksDone++;
+		}
+		if (chunksDone) {
+			std::lock_guard<std::mutex> lock(jobMutex);
+			if (error && !jobError) jobError = error;
+			chunksLeft -= chunksDone;
+			if (!chunksLeft) jobFinished.notify_one();
+		}
+	}
+}
+
+bool BulkParser::popChunk(std::size_t workerIndex, Chunk & chunk) {
+	auto & worker = *workers[workerIndex];
+	std::lock_guard<std::mutex> lock(worker.mutex);
+	if (worker.chunks.empty()) return false;
+	chunk = worker.chunks.back();
+	worker.chunks.pop_back();
+	return true;
+}
+
+bool BulkParser::stealChunk(std::size_t workerIndex, Chunk & chunk) {
+	for (std::size_t i = 1; i < workers.size(); i++) {
+		auto & victim = *workers[(workerIndex + i) % workers.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (victim.chunks.empty()) continue;
+		chunk = victim.chunks.front();
+		victim.chunks.pop_front();
+		return true;
+	}
+	return false;
+}
+
+} //namespace metaf
+
+#endif //#ifndef METAF_BULK_HPP
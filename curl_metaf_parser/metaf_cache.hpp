@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Cache of parse results for reports which are received repeatedly                         //
+//                                                                                            //
+//   Polls with hoursBeforeNow receive mostly the same reports as the previous poll. Results  //
+//   are cached by hash of report text with delimiter runs replaced by single space (parse    //
+//   result does not depend on delimiters); least recently used results are evicted when      //
+//   the cache grows over its memory limit. Results are immutable and shared, so a cached     //
+//   result stays valid for its users after eviction. Cache may be used by several threads.   //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef METAF_CACHE_HPP
+#define METAF_CACHE_HPP
+
+#include "METAF.hpp"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace metaf {
+
+class ParseCache {
+public:
+	struct Statistics {
+		std::size_t hits = 0;
+		std::size_t misses = 0;
+		std::size_t evictions = 0;
+		std::size_t entries = 0;
+		std::size_t bytes = 0; // estimated memory used by cached results
+	};
+
+	inline explicit ParseCache(std::size_t memoryLimit = 64 * 1024 * 1024);
+	ParseCache(const ParseCache &) = delete;
+	ParseCache & operator=(const ParseCache &) = delete;
+
+	// Returns cached result of the report, or parses the report with the
+	// context and caches the result
+	inline std::shared_ptr<const ParseResult> parse(std::string_view report,
+		ParseContext & context);
+	std::shared_ptr<const ParseResult> parse(std::string_view report) {
+		ParseContext context;
+		return parse(report, context);
+	}
+	// Returns cached result of the report or nullptr; does not count as
+	// a hit or miss
+	inline std::shared_ptr<const ParseResult> find(std::string_view report);
+
+	inline Statistics statistics() const;
+	std::size_t memoryLimit() const { return limit; }
+	inline void clear();
+
+	// Report text with leading and trailing delimiters removed and other
+	// delimiter runs replaced by single space
+	inline static std::string normalize(std::string_view report);
+	// FNV-1a hash of normalized report text, computed without normalizing
+	inline static std::uint64_t hash(std::string_view report);
+
+private:
+	struct Entry {
+		std::uint64_t hash;
+		std::string normalized;
+		std::shared_ptr<const ParseResult> result;
+		std::size_t bytes;
+	};
+	using EntryList = std::list<Entry>;
+
+	static bool isDelimiter(char c) { return (c <= ' '); }
+	inline static std::size_t estimateBytes(const Entry & entry);
+	inline static bool isSame(std::string_view normalized, std::string_view report);
+	// Must be called with mutex locked
+	inline EntryList::iterator lookup(std::uint64_t h, std::string_view report);
+
+	const std::size_t limit;
+	mutable std::mutex mutex;
+	// Most recently used first
+	EntryList entries;
+	std::unordered_map<std::uint64_t, EntryList::iterator> index;
+	Statistics stats;
+};
+
+ParseCache::ParseCache(std::size_t memoryLimit) : limit(memoryLimit) {}
+
+std::shared_ptr<const ParseResult> ParseCache::parse(std::string_view report,
+	ParseContext & context)
+{
+	const auto h = hash(report);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (const auto it = lookup(h, report); it != entries.end()) {
+			stats.hits++;
+			return it->result;
+		}
+		stats.misses++;
+	}
+
+	// Other threads are not blocked while the report is parsed
+	auto result = std::make_shared<const ParseResult>(Parser::parse(report, context));
+	Entry entry{h, normalize(report), result, 0};
+	entry.bytes = estimateBytes(entry);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	// Report could be cached meanwhile by another thread; entry with the same
+	// hash but different text is replaced
+	if (const auto it = index.find(h); it != index.end()) {
+		stats.bytes -= it->second->bytes;
+		entries.erase(it->second);
+		index.erase(it);
+	}
+	entries.push_front(std::move(entry));
+	index.emplace(h, entries.begin());
+	stats.bytes += entries.front().bytes;
+	// The entry just added is kept even if it alone is over the limit
+	while (stats.bytes > limit && entries.size() > 1) {
+		stats.bytes -= entries.back().bytes;
+		index.erase(entries.back().hash);
+		entries.pop_back();
+		stats.evictions++;
+	}
+	stats.entries = entries.size();
+	return result;
+}
+
+std::shared_ptr<const ParseResult> ParseCache::find(std::string_view report) {
+	const auto h = hash(report);
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto it = lookup(h, report);
+	if (it == entries.end()) return std::shared_ptr<const ParseResult>();
+	return it->result;
+}
+
+ParseCache::Statistics ParseCache::statistics() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats;
+}
+
+void ParseCache::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.clear();
+	index.clear();
+	stats.entries = 0;
+	stats.bytes = 0;
+}
+
+ParseCache::EntryList::iterator ParseCache::lookup(std::uint64_t h, std::string_view report) {
+	const auto it = index.find(h);
+	if (it == index.end() || !isSame(it->second->normalized, report)) return entries.end();
+	entries.splice(entries.begin(), entries, it->second);
+	return it->second;
+}
+
+std::string ParseCache::normalize(std::string_view report) {
+	std::string result;
+	result.reserve(report.length());
+	bool delimiter = false;
+	for (const auto c : report) {
+		if (isDelimiter(c)) {
+			delimiter = true;
+			continue;
+		}
+		if (delimiter && !result.empty()) result.push_back(' ');
+		delimiter = false;
+		result.push_back(c);
+	}
+	return result;
+}
+
+std::uint64_t ParseCache::hash(std::string_view report) {
+	std::uint64_t h = 14695981039346656037ull;
+	const auto add = [&h](char c) {
+		h ^= static_cast<unsigned char>(c);
+		h *= 1099511628211ull;
+	};
+	bool delimiter = false;
+	bool empty = true;
+	for (const auto c : report) {
+		if (isDelimiter(c)) {
+			delimiter = true;
+			continue;
+		}
+		if (delimiter && !empty) add(' ');
+		delimiter = false;
+		empty = false;
+		add(c);
+	}
+	return h;
+}
+
+bool ParseCache::isSame(std::string_view normalized, std::string_view report) {
+	std::size_t i = 0;
+	bool delimiter = false;
+	for (const auto c : report) {
+		if (isDelimiter(c)) {
+			delimiter = true;
+			continue;
+		}
+		if (delimiter && i) {
+			if (i >= normalized.length() || normalized[i++] != ' ') return false;
+		}
+		delimiter = false;
+		if (i >= normalized.length() || normalized[i++] != c) return false;
+	}
+	return (i == normalized.length());
+}
+
+std::size_t ParseCache::estimateBytes(const Entry & entry) {
+	// Heap blocks of strings which do not fit into their own storage, plus
+	// list node, index node and shared result block
+	static const auto inplaceCapacity = std::string().capacity();
+	const auto heap = [](const std::string & s) {
+		return (s.capacity() > inplaceCapacity) ? s.capacity() + 1 : 0;
+	};
+	const auto & result = *entry.result;
+	std::size_t bytes = sizeof(Entry) + 4 * sizeof(void *) +
+		sizeof(ParseResult) + 2 * sizeof(void *) +
+		heap(entry.normalized) + heap(result.reportMetadata.icaoLocation) +
+		result.groups.capacity() * sizeof(GroupInfo);
+	for (const auto & group : result.groups) bytes += heap(group.rawString);
+	return bytes;
+}
+
+} //namespace metaf
+
+#endif //#ifndef METAF_CACHE_HPP
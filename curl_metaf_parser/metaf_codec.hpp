@@ -0,0 +1,363 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Compact binary encoding of raw METAR and TAF reports                                     //
+//                                                                                            //
+//   Report is split into group strings (tokens) at delimiters, the same way as the parser    //
+//   does; every token found in the dictionary is encoded as its ID, other tokens are stored  //
+//   as literals. Dictionary is either the built-in one or trained on a set of reports.       //
+//   Encoding is exact: decoded report is byte for byte the same as the encoded one.          //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef METAF_CODEC_HPP
+#define METAF_CODEC_HPP
+
+#include "METAF.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace metaf {
+
+// Tokens of dictionary; frequent tokens should come first since they get
+// shorter IDs. Encoded reports can only be decoded with the dictionary
+// which was used to encode them.
+class ReportDictionary {
+public:
+	ReportDictionary() = default;
+	ReportDictionary(const ReportDictionary &) = delete;
+	ReportDictionary & operator=(const ReportDictionary &) = delete;
+	// Tokens are not moved in memory, views in index remain valid
+	ReportDictionary(ReportDictionary &&) = default;
+	ReportDictionary & operator=(ReportDictionary &&) = default;
+
+	// Common METAR and TAF tokens (keywords, weather phenomena, pressure,
+	// clouds, visibility); this dictionary never changes
+	inline static const ReportDictionary & builtin();
+	// Dictionary of tokens which occur in reports at least minCount times,
+	// most frequent first. Reports may be any range of strings or string
+	// views.
+	template <typename Reports>
+	static ReportDictionary train(const Reports & reports,
+		std::size_t maxSize = 65536,
+		std::size_t minCount = 2);
+
+	std::size_t size() const { return tokens.size(); }
+	const std::string & token(std::size_t id) const { return tokens[id]; }
+	inline std::optional<std::uint32_t> find(std::string_view token) const;
+
+	// Dictionary is stored as text, one token per line after the header
+	inline void save(std::ostream & output) const;
+	inline static std::optional<ReportDictionary> load(std::istream & input,
+		std::string & error);
+
+	// Same delimiters as used by the parser
+	static bool isDelimiter(char c) { return (c <= ' '); }
+
+private:
+	inline void add(std::string_view token);
+
+	static const inline char header[] = "metaf-report-dictionary 1";
+
+	std::deque<std::string> tokens;
+	std::unordered_map<std::string_view, std::uint32_t> index;
+};
+
+// Encoded report is a sequence of items, each beginning with variable-
+// length code (7 bits per byte, least significant first):
+//   0, length, bytes    literal token
+//   1, length, bytes    delimiters other than single space between tokens
+//                       (also leading and trailing delimiters)
+//   2 + ID              dictionary token
+// Consecutive tokens are separated by single space unless delimiters
+// are given explicitly.
+class ReportCodec {
+public:
+	// Dictionary must outlive the codec
+	explicit ReportCodec(const ReportDictionary & dictionary = ReportDictionary::builtin()) :
+		dict(dictionary) {}
+
+	// Appends encoded report to output
+	inline void encode(std::string_view report, std::string & output) const;
+	std::string encode(std::string_view report) const {
+		std::string output;
+		encode(report, output);
+		return output;
+	}
+	// Decodes report into output (replacing its contents); returns false
+	// if encoded data are corrupt
+	inline bool decode(std::string_view encoded, std::string & output) const;
+	// Decodes report into its group strings for Parser::parseGroups(),
+	// without building report text; views refer to the dictionary and to
+	// encoded data. Delimiters are dropped. Returns false if encoded data
+	// are corrupt.
+	inline bool decodeGroups(std::string_view encoded,
+		std::vector<std::string_view> & groups) const;
+
+private:
+	enum Code : std::uint32_t {
+		LITERAL = 0,
+		DELIMITERS = 1,
+		FIRST_TOKEN = 2
+	};
+
+	inline static void putCode(std::uint32_t code, std::string & output);
+	inline static void putBytes(std::uint32_t code,
+		std::string_view bytes,
+		std::string & output);
+	inline static bool getCode(std::string_view encoded,
+		std::size_t & pos,
+		std::uint32_t & code);
+	inline static bool getBytes(std::string_view encoded,
+		std::size_t & pos,
+		std::string_view & bytes);
+	// Reads next item; token is empty if the item is delimiters
+	inline bool next(std::string_view encoded,
+		std::size_t & pos,
+		std::string_view & token,
+		std::string_view & delimiters) const;
+
+	const ReportDictionary & dict;
+};
+
+const ReportDictionary & ReportDictionary::builtin() {
+	static const ReportDictionary dictionary = [] {
+		ReportDictionary d;
+		static const char * const keywords[] = {
+			"METAR", "SPECI", "TAF", "AMD", "COR", "AUTO", "NIL", "CNL", "RMK",
+			"NOSIG", "CAVOK", "TEMPO", "BECMG", "INTER", "PROB30", "PROB40",
+			"NSC", "NCD", "NSW", "SKC", "CLR", "AO1", "AO2", "AO2A", "SLPNO",
+			"9999", "0000", "P6SM", "10SM", "//////", "/////", "////", "//",
+			"BR", "FG", "HZ", "FU", "DU", "SA", "DS", "SS", "SQ", "FC", "TS",
+			"-RA", "RA", "+RA", "-DZ", "DZ", "-SN", "SN", "+SN", "-SG", "SG",
+			"GR", "GS", "PL", "-SHRA", "SHRA", "+SHRA", "-SHSN", "SHSN",
+			"-TSRA", "TSRA", "+TSRA", "-RASN", "RASN", "-FZRA", "FZRA",
+			"-FZDZ", "FZDZ", "FZFG", "BCFG", "MIFG", "PRFG", "BLSN", "DRSN",
+			"VCSH", "VCTS", "VCFG", "RERA", "RESHRA", "RETS", "RESN", "REDZ",
+			"WS", "ALL", "RWY", "TCU", "CB", "FEW///", "SCT///", "BKN///",
+			"OVC///", "FEW///CB", "BKN///CB", "VV///", "FROIN", "TSNO", "PNO",
+			"FZRANO", "RVRNO", "VISNO", "CHINO", "PWINO", "$", "ACC", "ACSL",
+			"CONS", "LTG", "LTGIC", "LTGCG", "LTGICCG", "OHD", "DSNT", "VC",
+			"NE", "SE", "SW", "NW", "N", "E", "S", "W", "AND", "MOV",
+		};
+		for (const auto keyword : keywords) d.add(keyword);
+		const auto number = [](unsigned int value, std::size_t digits) {
+			auto s = std::to_string(value);
+			return std::string(digits > s.length() ? digits - s.length() : 0, '0') + s;
+		};
+		for (auto hpa = 960u; hpa <= 1050u; hpa++) d.add("Q" + number(hpa, 4));
+		for (auto inhg = 2900u; inhg <= 3100u; inhg++) d.add("A" + number(inhg, 4));
+		std::vector<unsigned int> heights;
+		for (auto h = 1u; h <= 30u; h++) heights.push_back(h);
+		for (auto h = 35u; h <= 100u; h += 5) heights.push_back(h);
+		for (auto h = 110u; h <= 250u; h += 10) heights.push_back(h);
+		for (const auto amount : { "FEW", "SCT", "BKN", "OVC" })
+			for (const auto h : heights) d.add(amount + number(h, 3));
+		for (auto h = 1u; h <= 10u; h++) d.add("VV" + number(h, 3));
+		for (auto m = 50u; m <= 800u; m += 50) d.add(number(m, 4));
+		for (auto m = 900u; m <= 5000u; m += 100) d.add(number(m, 4));
+		for (auto m = 6000u; m <= 9000u; m += 1000) d.add(number(m, 4));
+		for (auto sm = 1u; sm <= 15u; sm++) d.add(std::to_string(sm) + "SM");
+		for (const auto sm : { "1/4SM", "1/2SM", "3/4SM", "M1/4SM" }) d.add(sm);
+		for (auto v = 0u; v <= 10u; v++) {
+			d.add("VRB" + number(v, 2) + "KT");
+			d.add("VRB" + number(v, 2) + "MPS");
+		}
+		d.add("00000KT");
+		d.add("00000MPS");
+		return d;
+	}();
+	return dictionary;
+}
+
+template <typename Reports>
+ReportDictionary ReportDictionary::train(const Reports & reports,
+	std::size_t maxSize,
+	std::size_t minCount)
+{
+	std::unordered_map<std::string, std::size_t> counts;
+	for (const auto & r : reports) {
+		const std::string_view report(r);
+		std::size_t pos = 0;
+		while (pos < report.length()) {
+			while (pos < report.length() && isDelimiter(report[pos])) pos++;
+			const auto begin = pos;
+			while (pos < report.length() && !isDelimiter(report[pos])) pos++;
+			if (pos > begin) counts[std::string(report.substr(begin, pos - begin))]++;
+		}
+	}
+	std::vector<std::pair<std::size_t, std::string_view>> frequent;
+	for (const auto & [token, count] : counts)
+		if (count >= minCount) frequent.emplace_back(count, token);
+	// Ties are ordered by token so that training is deterministic
+	std::sort(frequent.begin(), frequent.end(), [](const auto & a, const auto & b) {
+		if (a.first != b.first) return a.first > b.first;
+		return a.second < b.second;
+	});
+	if (frequent.size() > maxSize) frequent.resize(maxSize);
+	ReportDictionary dictionary;
+	for (const auto & entry : frequent) dictionary.add(entry.second);
+	return dictionary;
+}
+
+std::optional<std::uint32_t> ReportDictionary::find(std::string_view token) const {
+	const auto it = index.find(token);
+	if (it == index.end()) return std::optional<std::uint32_t>();
+	return it->second;
+}
+
+void ReportDictionary::save(std::ostream & output) const {
+	output << header << '\n';
+	for (const auto & token : tokens) output << token << '\n';
+}
+
+std::optional<ReportDictionary> ReportDictionary::load(std::istream & input,
+	std::string & error)
+{
+	std::string line;
+	if (!std::getline(input, line) || line != header) {
+		error = "not a report dictionary";
+		return std::optional<ReportDictionary>();
+	}
+	ReportDictionary dictionary;
+	while (std::getline(input, line)) {
+		const auto delimiter = std::find_if(line.begin(), line.end(), isDelimiter);
+		if (line.empty() || delimiter != line.end() || dictionary.find(line)) {
+			error = "invalid token in dictionary: " + line;
+			return std::optional<ReportDictionary>();
+		}
+		dictionary.add(line);
+	}
+	return dictionary;
+}
+
+void ReportDictionary::add(std::string_view token) {
+	if (index.count(token)) return;
+	tokens.emplace_back(token);
+	index.emplace(tokens.back(), static_cast<std::uint32_t>(tokens.size() - 1));
+}
+
+void ReportCodec::encode(std::string_view report, std::string & output) const {
+	std::size_t pos = 0;
+	bool afterToken = false;
+	while (pos < report.length()) {
+		const auto delimitersBegin = pos;
+		while (pos < report.length() && ReportDictionary::isDelimiter(report[pos])) pos++;
+		const auto delimiters = report.substr(delimitersBegin, pos - delimitersBegin);
+		const auto tokenBegin = pos;
+		while (pos < report.length() && !ReportDictionary::isDelimiter(report[pos])) pos++;
+		const auto token = report.substr(tokenBegin, pos - tokenBegin);
+
+		// Single space between tokens is implied
+		if (!(afterToken && !token.empty() && delimiters == " ") && !delimiters.empty())
+			putBytes(DELIMITERS, delimiters, output);
+		if (token.empty()) break;
+		if (const auto id = dict.find(token); id.has_value())
+			putCode(FIRST_TOKEN + *id, output);
+		else
+			putBytes(LITERAL, token, output);
+		afterToken = true;
+	}
+}
+
+bool ReportCodec::decode(std::string_view encoded, std::string & output) const {
+	output.clear();
+	std::size_t pos = 0;
+	bool afterToken = false;
+	while (pos < encoded.length()) {
+		std::string_view token, delimiters;
+		if (!next(encoded, pos, token, delimiters)) return false;
+		if (token.empty()) {
+			output += delimiters;
+			afterToken = false;
+			continue;
+		}
+		if (afterToken) output.push_back(' ');
+		output += token;
+		afterToken = true;
+	}
+	return true;
+}
+
+bool ReportCodec::decodeGroups(std::string_view encoded,
+	std::vector<std::string_view> & groups) const
+{
+	groups.clear();
+	std::size_t pos = 0;
+	while (pos < encoded.length()) {
+		std::string_view token, delimiters;
+		if (!next(encoded, pos, token, delimiters)) return false;
+		if (!token.empty()) groups.push_back(token);
+	}
+	return true;
+}
+
+void ReportCodec::putCode(std::uint32_t code, std::string & output) {
+	while (code >= 0x80) {
+		output.push_back(static_cast<char>((code & 0x7F) | 0x80));
+		code >>= 7;
+	}
+	output.push_back(static_cast<char>(code));
+}
+
+void ReportCodec::putBytes(std::uint32_t code, std::string_view bytes, std::string & output) {
+	putCode(code, output);
+	putCode(static_cast<std::uint32_t>(bytes.length()), output);
+	output += bytes;
+}
+
+bool ReportCodec::getCode(std::string_view encoded, std::size_t & pos, std::uint32_t & code) {
+	code = 0;
+	for (unsigned int shift = 0; shift < 32; shift += 7) {
+		if (pos >= encoded.length()) return false;
+		const auto byte = static_cast<unsigned char>(encoded[pos++]);
+		code |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) return true;
+	}
+	return false;
+}
+
+bool ReportCodec::getBytes(std::string_view encoded,
+	std::size_t & pos,
+	std::string_view & bytes)
+{
+	std::uint32_t length;
+	if (!getCode(encoded, pos, length) || length > encoded.length() - pos) return false;
+	bytes = encoded.substr(pos, length);
+	pos += length;
+	return true;
+}
+
+bool ReportCodec::next(std::string_view encoded,
+	std::size_t & pos,
+	std::string_view & token,
+	std::string_view & delimiters) const
+{
+	token = delimiters = std::string_view();
+	std::uint32_t code;
+	if (!getCode(encoded, pos, code)) return false;
+	switch (code) {
+		case LITERAL:
+		return (getBytes(encoded, pos, token) && !token.empty());
+
+		case DELIMITERS:
+		return (getBytes(encoded, pos, delimiters) && !delimiters.empty());
+
+		default:
+		if (code - FIRST_TOKEN >= dict.size()) return false;
+		token = dict.token(code - FIRST_TOKEN);
+		return true;
+	}
+}
+
+} //namespace metaf
+
+#endif //#ifndef METAF_CODEC_HPP
@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Read-only memory-mapped files                                                            //
+//                                                                                            //
+//   Whole file is mapped into memory at once; pages are loaded by the OS when accessed,      //
+//   so opening even a large file is fast and nothing is copied. Access pattern hint lets     //
+//   the OS read ahead when file is scanned sequentially.                                     //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef METAF_MMAP_HPP
+#define METAF_MMAP_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <cerrno>
+	#include <cstring>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace metaf {
+
+class MappedFile {
+public:
+	enum class Access {
+		NORMAL,
+		SEQUENTIAL, // read ahead aggressively, e.g. when scanning archives
+		RANDOM      // do not read ahead, e.g. when looking up snapshot columns
+	};
+
+	MappedFile() = default;
+	~MappedFile() { close(); }
+	MappedFile(const MappedFile &) = delete;
+	MappedFile & operator=(const MappedFile &) = delete;
+	MappedFile(MappedFile && other) noexcept { swap(other); }
+	MappedFile & operator=(MappedFile && other) noexcept {
+		if (this != &other) { close(); swap(other); }
+		return *this;
+	}
+
+	// Maps the whole file; on failure returns false and describes the
+	// error. Empty file is opened with no data.
+	inline bool open(const std::string & path,
+		std::string & error,
+		Access access = Access::NORMAL);
+	inline void close();
+	// Tells the OS that data before offset will not be accessed soon, so
+	// that their pages may be dropped; large files scanned sequentially
+	// then do not fill the memory. Data remain accessible.
+	inline void release(std::size_t offset);
+
+	bool isOpen() const { return opened; }
+	const char * data() const { return mapping; }
+	std::size_t size() const { return length; }
+	std::string_view view() const { return std::string_view(mapping, length); }
+
+private:
+	inline void swap(MappedFile & other) noexcept;
+
+	const char * mapping = nullptr;
+	std::size_t length = 0;
+	std::size_t released = 0;
+	bool opened = false;
+};
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string & path, std::string & error, Access access) {
+	close();
+	DWORD flags = FILE_ATTRIBUTE_NORMAL;
+	if (access == Access::SEQUENTIAL) flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+	if (access == Access::RANDOM) flags |= FILE_FLAG_RANDOM_ACCESS;
+	const auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, flags, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		error = "cannot open " + path;
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		error = "cannot get size of " + path;
+		return false;
+	}
+	if (fileSize.QuadPart) {
+		// View keeps the mapping alive after both handles are closed
+		const auto fileMapping =
+			CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (fileMapping) {
+			mapping = static_cast<const char *>(
+				MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0));
+			CloseHandle(fileMapping);
+		}
+		if (!mapping) {
+			CloseHandle(file);
+			error = "cannot map " + path;
+			return false;
+		}
+	}
+	CloseHandle(file);
+	length = static_cast<std::size_t>(fileSize.QuadPart);
+	opened = true;
+	return true;
+}
+
+void MappedFile::close() {
+	if (mapping) UnmapViewOfFile(mapping);
+	mapping = nullptr;
+	length = 0;
+	released = 0;
+	opened = false;
+}
+
+void MappedFile::release(std::size_t offset) {
+	// Unmodified pages of mapped files are trimmed by the OS as needed
+	(void)offset;
+}
+
+#else
+
+bool MappedFile::open(const std::string & path, std::string & error, Access access) {
+	close();
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		error = "cannot open " + path + ": " + std::strerror(errno);
+		return false;
+	}
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) < 0) {
+		error = "cannot get size of " + path + ": " + std::strerror(errno);
+		::close(fd);
+		return false;
+	}
+	const auto fileSize = static_cast<std::size_t>(fileStat.st_size);
+	if (fileSize) {
+		// Mapping stays valid after the descriptor is closed
+		void * p = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p == MAP_FAILED) {
+			error = "cannot map " + path + ": " + std::strerror(errno);
+			::close(fd);
+			return false;
+		}
+		mapping = static_cast<const char *>(p);
+		// Hint is only an optimisation, failure is not an error
+		if (access == Access::SEQUENTIAL) madvise(p, fileSize, MADV_SEQUENTIAL);
+		if (access == Access::RANDOM) madvise(p, fileSize, MADV_RANDOM);
+	}
+	::close(fd);
+	length = fileSize;
+	opened = true;
+	return true;
+}
+
+void MappedFile::close() {
+	if (mapping) munmap(const_cast<char *>(mapping), length);
+	mapping = nullptr;
+	length = 0;
+	released = 0;
+	opened = false;
+}
+
+void MappedFile::release(std::size_t offset) {
+	// Only whole pages can be released; pages of read-only file mapping
+	// are read from the file again if accessed later
+	static const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+	const auto end = (offset < length ? offset : length) / pageSize * pageSize;
+	if (end <= released) return;
+	madvise(const_cast<char *>(mapping) + released, end - released, MADV_DONTNEED);
+	released = end;
+}
+
+#endif
+
+void MappedFile::swap(MappedFile & other) noexcept {
+	std::swap(mapping, other.mapping);
+	std::swap(length, other.length);
+	std::swap(released, other.released);
+	std::swap(opened, other.opened);
+}
+
+} //namespace metaf
+
+#endif //#ifndef METAF_MMAP_HPP
@@ -0,0 +1,733 @@
+////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                            //
+//   Columnar binary snapshots of parsed METAR and TAF reports                                //
+//                                                                                            //
+//   Snapshot stores report metadata and the most used group data column by column (report    //
+//   times, locations, wind, visibility, clouds, temperature, pressure), together with raw    //
+//   report and group strings. Snapshot file may be memory-mapped and queried as it is:       //
+//   columns are accessed in place, nothing is deserialised or parsed on load.                //
+//                                                                                            //
+//   File layout (host byte order, checked on load):                                          //
+//     header        magic "METAFSNP", format version, metaf version, report and group count  //
+//     directory     column ID, element size, offset and element count of every column        //
+//     columns       arrays of fixed-size elements, each aligned to 8 bytes                   //
+//   Snapshot is tied to the metaf version which wrote it, since enumerations stored in       //
+//   columns may change between versions; snapshot of another version is rejected.            //
+//                                                                                            //
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef METAF_SNAPSHOT_HPP
+#define METAF_SNAPSHOT_HPP
+
+#include "METAF.hpp"
+#include "metaf_mmap.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace metaf {
+
+// Column IDs are stored in snapshot files and must never be reused;
+// element type and unit of each column are given in the comments.
+// Rows of report table are reports, rows of group table are groups;
+// rows of wind, visibility, cloud, temperature and pressure tables are
+// groups of that type and refer to their row in group table.
+enum class SnapshotColumn : std::uint32_t {
+	REPORT_TYPE = 1,            // uint8_t, ReportType
+	REPORT_ERROR = 2,           // uint8_t, ReportError
+	REPORT_FLAGS = 3,           // uint16_t, SnapshotFlags bits
+	REPORT_LOCATION = 4,        // char[4], ICAO location padded with zeros
+	REPORT_TIME = 5,            // uint32_t, packed time (see SnapshotView)
+	REPORT_TIME_FROM = 6,       // uint32_t, packed time
+	REPORT_TIME_UNTIL = 7,      // uint32_t, packed time
+	REPORT_CORRECTION = 8,      // uint16_t, correction number
+	REPORT_TEXT_END = 9,        // uint64_t, end of raw report in REPORT_TEXT
+	REPORT_TEXT = 10,           // char, raw reports one after another
+	REPORT_GROUP_END = 11,      // uint32_t, end of report's rows in group table
+	GROUP_TYPE = 20,            // uint8_t, index of group type in Group variant
+	GROUP_PART = 21,            // uint8_t, ReportPart
+	GROUP_TEXT_END = 22,        // uint64_t, end of raw group in GROUP_TEXT
+	GROUP_TEXT = 23,            // char, raw groups one after another
+	WIND_GROUP = 30,            // uint32_t, row in group table
+	WIND_TYPE = 31,             // uint8_t, WindGroup::Type
+	WIND_DIRECTION = 32,        // uint16_t, degrees
+	WIND_SPEED = 33,            // float, knots
+	WIND_GUST = 34,             // float, knots
+	VISIBILITY_GROUP = 40,      // uint32_t, row in group table
+	VISIBILITY_TYPE = 41,       // uint8_t, VisibilityGroup::Type
+	VISIBILITY_DISTANCE = 42,   // float, meters
+	CLOUD_GROUP = 50,           // uint32_t, row in group table
+	CLOUD_TYPE = 51,            // uint8_t, CloudGroup::Type
+	CLOUD_AMOUNT = 52,          // uint8_t, CloudGroup::Amount
+	CLOUD_CONVECTIVE_TYPE = 53, // uint8_t, CloudGroup::ConvectiveType
+	CLOUD_HEIGHT = 54,          // float, feet
+	TEMPERATURE_GROUP = 60,     // uint32_t, row in group table
+	TEMPERATURE_TYPE = 61,      // uint8_t, TemperatureGroup::Type
+	TEMPERATURE_AIR = 62,       // float, degrees Celsius
+	TEMPERATURE_DEW_POINT = 63, // float, degrees Celsius
+	PRESSURE_GROUP = 70,        // uint32_t, row in group table
+	PRESSURE_TYPE = 71,         // uint8_t, PressureGroup::Type
+	PRESSURE_VALUE = 72,        // float, hectopascals
+};
+
+// Bits of REPORT_FLAGS column
+struct SnapshotFlags {
+	static const inline std::uint16_t SPECI = 0x0001;
+	static const inline std::uint16_t NOSPECI = 0x0002;
+	static const inline std::uint16_t AUTOMATED = 0x0004;
+	static const inline std::uint16_t AO1 = 0x0008;
+	static const inline std::uint16_t AO1A = 0x0010;
+	static const inline std::uint16_t AO2 = 0x0020;
+	static const inline std::uint16_t AO2A = 0x0040;
+	static const inline std::uint16_t NIL = 0x0080;
+	static const inline std::uint16_t CANCELLED = 0x0100;
+	static const inline std::uint16_t AMENDED = 0x0200;
+	static const inline std::uint16_t CORRECTIONAL = 0x0400;
+	static const inline std::uint16_t MAINTENANCE = 0x0800;
+};
+
+// Missing values: integer columns use the maximum value of their type,
+// float columns use NaN
+template <typename T>
+constexpr T snapshotMissing() {
+	if constexpr (std::is_floating_point_v<T>)
+		return std::numeric_limits<T>::quiet_NaN();
+	else
+		return std::numeric_limits<T>::max();
+}
+
+// Builds snapshot in memory from parsed reports and writes it out
+class SnapshotWriter {
+public:
+	inline void add(std::string_view report, const ParseResult & result);
+	std::size_t reportCount() const { return reportTypes.size(); }
+	std::size_t groupCount() const { return groupTypes.size(); }
+	inline void clear();
+
+	// Returns false if the output failed
+	inline bool write(std::ostream & output) const;
+
+private:
+	inline static std::uint32_t packTime(const std::optional<MetafTime> & time);
+	inline static std::uint32_t row(std::size_t index);
+	template <typename T>
+	inline static void push(std::vector<T> & column, std::optional<T> value);
+	inline void addGroup(const GroupInfo & groupInfo);
+
+	std::vector<std::uint8_t> reportTypes;
+	std::vector<std::uint8_t> reportErrors;
+	std::vector<std::uint16_t> reportFlags;
+	std::vector<char> reportLocations;
+	std::vector<std::uint32_t> reportTimes;
+	std::vector<std::uint32_t> reportTimesFrom;
+	std::vector<std::uint32_t> reportTimesUntil;
+	std::vector<std::uint16_t> reportCorrections;
+	std::vector<std::uint64_t> reportTextEnds;
+	std::vector<char> reportText;
+	std::vector<std::uint32_t> reportGroupEnds;
+
+	std::vector<std::uint8_t> groupTypes;
+	std::vector<std::uint8_t> groupParts;
+	std::vector<std::uint64_t> groupTextEnds;
+	std::vector<char> groupText;
+
+	std::vector<std::uint32_t> windGroups;
+	std::vector<std::uint8_t> windTypes;
+	std::vector<std::uint16_t> windDirections;
+	std::vector<float> windSpeeds;
+	std::vector<float> windGusts;
+
+	std::vector<std::uint32_t> visibilityGroups;
+	std::vector<std::uint8_t> visibilityTypes;
+	std::vector<float> visibilityDistances;
+
+	std::vector<std::uint32_t> cloudGroups;
+	std::vector<std::uint8_t> cloudTypes;
+	std::vector<std::uint8_t> cloudAmounts;
+	std::vector<std::uint8_t> cloudConvectiveTypes;
+	std::vector<float> cloudHeights;
+
+	std::vector<std::uint32_t> temperatureGroups;
+	std::vector<std::uint8_t> temperatureTypes;
+	std::vector<float> temperatureAir;
+	std::vector<float> temperatureDewPoints;
+
+	std::vector<std::uint32_t> pressureGroups;
+	std::vector<std::uint8_t> pressureTypes;
+	std::vector<float> pressureValues;
+};
+
+// Column of snapshot; points into the snapshot data
+template <typename T>
+class SnapshotArray {
+public:
+	SnapshotArray() = default;
+	SnapshotArray(const T * d, std::size_t s) : elements(d), count(s) {}
+	std::size_t size() const { return count; }
+	bool empty() const { return !count; }
+	const T & operator[](std::size_t index) const { return elements[index]; }
+	const T * begin() const { return elements; }
+	const T * end() const { return elements + count; }
+
+private:
+	const T * elements = nullptr;
+	std::size_t count = 0;
+};
+
+// Read-only view of snapshot data (e.g. memory-mapped file). View does
+// not own the data, which must stay valid and unchanged while the view
+// is used. Data must be aligned to 8 bytes, as mapped files always are.
+class SnapshotView {
+public:
+	// Validates header and column directory only; returns no value and
+	// describes the error if data are not a valid snapshot
+	inline static std::optional<SnapshotView> load(const char * data,
+		std::size_t size,
+		std::string & error);
+
+	std::size_t reportCount() const { return reports; }
+	std::size_t groupCount() const { return groups; }
+
+	// Column data; empty if the snapshot has no such column or the
+	// element type does not match
+	template <typename T>
+	SnapshotArray<T> column(SnapshotColumn id) const {
+		const auto index = static_cast<std::size_t>(id);
+		if (index >= columns.size() || columns[index].elementSize != sizeof(T))
+			return SnapshotArray<T>();
+		return SnapshotArray<T>(
+			reinterpret_cast<const T *>(columns[index].data), columns[index].count);
+	}
+
+	ReportType reportType(std::size_t report) const {
+		return static_cast<ReportType>(column<std::uint8_t>(SnapshotColumn::REPORT_TYPE)[report]);
+	}
+	inline std::string_view location(std::size_t report) const;
+	std::optional<MetafTime> reportTime(std::size_t report) const {
+		return unpackTime(column<std::uint32_t>(SnapshotColumn::REPORT_TIME)[report]);
+	}
+	inline std::string_view rawReport(std::size_t report) const;
+	// Rows of the report's groups in group table: [first, second)
+	inline std::pair<std::size_t, std::size_t> groupRange(std::size_t report) const;
+	inline std::string_view rawGroup(std::size_t group) const;
+	// Metadata as it was returned by the parser
+	inline ReportMetadata metadata(std::size_t report) const;
+	// Complete parse result with all groups, by parsing raw report again
+	ParseResult parse(std::size_t report) const {
+		return Parser::parse(rawReport(report));
+	}
+
+	// Packed time is ((day << 16) | (hour << 8) | minute), with zero day
+	// if day is not specified
+	inline static std::optional<MetafTime> unpackTime(std::uint32_t packed);
+
+	static const inline char magic[8] = { 'M', 'E', 'T', 'A', 'F', 'S', 'N', 'P' };
+	static const inline std::uint32_t formatVersion = 1;
+	static const inline std::uint32_t byteOrderMark = 0x01020304;
+
+private:
+	friend class SnapshotWriter;
+
+	struct Header {
+		char magic[8];
+		std::uint32_t formatVersion;
+		std::uint32_t byteOrderMark;
+		std::uint32_t versionMajor;
+		std::uint32_t versionMinor;
+		std::uint32_t versionPatch;
+		std::uint32_t columnCount;
+		std::uint64_t reportCount;
+		std::uint64_t groupCount;
+	};
+	struct DirectoryEntry {
+		std::uint32_t id;
+		std::uint32_t elementSize;
+		std::uint64_t offset;
+		std::uint64_t count;
+	};
+	struct Column {
+		const char * data = nullptr;
+		std::uint32_t elementSize = 0;
+		std::size_t count = 0;
+	};
+
+	inline static std::string_view textOf(SnapshotArray<std::uint64_t> ends,
+		SnapshotArray<char> text,
+		std::size_t index);
+	// Element size of the column as given in SnapshotColumn comments, zero
+	// if column ID is unknown
+	inline static std::size_t elementSize(std::uint32_t id);
+
+	static const inline std::size_t alignment = 8;
+	static const inline std::size_t maxColumnId = 127;
+
+	std::array<Column, maxColumnId + 1> columns;
+	std::size_t reports = 0;
+	std::size_t groups = 0;
+};
+
+// Snapshot file mapped into memory
+class SnapshotFile {
+public:
+	// Maps the file and validates it as a snapshot; on failure returns
+	// false and describes the error
+	inline bool open(const std::string & path, std::string & error);
+	bool isOpen() const { return snapshot.has_value(); }
+	const SnapshotView & view() const { return *snapshot; }
+
+private:
+	MappedFile file;
+	std::optional<SnapshotView> snapshot;
+};
+
+void SnapshotWriter::add(std::string_view report, const ParseResult & result) {
+	const auto & metadata = result.reportMetadata;
+	reportTypes.push_back(static_cast<std::uint8_t>(metadata.type));
+	reportErrors.push_back(static_cast<std::uint8_t>(metadata.error));
+	std::uint16_t flags = 0;
+	if (metadata.isSpeci) flags |= SnapshotFlags::SPECI;
+	if (metadata.isNospeci) flags |= SnapshotFlags::NOSPECI;
+	if (metadata.isAutomated) flags |= SnapshotFlags::AUTOMATED;
+	if (metadata.isAo1) flags |= SnapshotFlags::AO1;
+	if (metadata.isAo1a) flags |= SnapshotFlags::AO1A;
+	if (metadata.isAo2) flags |= SnapshotFlags::AO2;
+	if (metadata.isAo2a) flags |= SnapshotFlags::AO2A;
+	if (metadata.isNil) flags |= SnapshotFlags::NIL;
+	if (metadata.isCancelled) flags |= SnapshotFlags::CANCELLED;
+	if (metadata.isAmended) flags |= SnapshotFlags::AMENDED;
+	if (metadata.isCorrectional) flags |= SnapshotFlags::CORRECTIONAL;
+	if (metadata.maintenanceIndicator) flags |= SnapshotFlags::MAINTENANCE;
+	reportFlags.push_back(flags);
+	// ICAO location is always 4 characters long
+	for (std::size_t i = 0; i < 4; i++) {
+		reportLocations.push_back(
+			(i < metadata.icaoLocation.length()) ? metadata.icaoLocation[i] : '\0');
+	}
+	reportTimes.push_back(packTime(metadata.reportTime));
+	reportTimesFrom.push_back(packTime(metadata.timeSpanFrom));
+	reportTimesUntil.push_back(packTime(metadata.timeSpanUntil));
+	push<std::uint16_t>(reportCorrections, metadata.correctionNumber);
+	reportText.insert(reportText.end(), report.begin(), report.end());
+	reportTextEnds.push_back(reportText.size());
+	for (const auto & groupInfo : result.groups) addGroup(groupInfo);
+	reportGroupEnds.push_back(row(groupTypes.size()));
+}
+
+void SnapshotWriter::addGroup(const GroupInfo & groupInfo) {
+	const auto group = row(groupTypes.size());
+	groupTypes.push_back(static_cast<std::uint8_t>(groupInfo.group.index()));
+	groupParts.push_back(static_cast<std::uint8_t>(groupInfo.reportPart));
+	groupText.insert(groupText.end(),
+		groupInfo.rawString.begin(), groupInfo.rawString.end());
+	groupTextEnds.push_back(groupText.size());
+
+	if (const auto wind = std::get_if<WindGroup>(&groupInfo.group)) {
+		windGroups.push_back(group);
+		windTypes.push_back(static_cast<std::uint8_t>(wind->type()));
+		push<std::uint16_t>(windDirections, wind->direction().degrees());
+		push<float>(windSpeeds, wind->windSpeed().toUnit(Speed::Unit::KNOTS));
+		push<float>(windGusts, wind->gustSpeed().toUnit(Speed::Unit::KNOTS));
+	}
+	if (const auto visibility = std::get_if<VisibilityGroup>(&groupInfo.group)) {
+		visibilityGroups.push_back(group);
+		visibilityTypes.push_back(static_cast<std::uint8_t>(visibility->type()));
+		push<float>(visibilityDistances,
+			visibility->visibility().toUnit(Distance::Unit::METERS));
+	}
+	if (const auto cloud = std::get_if<CloudGroup>(&groupInfo.group)) {
+		cloudGroups.push_back(group);
+		cloudTypes.push_back(static_cast<std::uint8_t>(cloud->type()));
+		cloudAmounts.push_back(static_cast<std::uint8_t>(cloud->amount()));
+		cloudConvectiveTypes.push_back(
+			static_cast<std::uint8_t>(cloud->convectiveType()));
+		push<float>(cloudHeights, cloud->height().toUnit(Distance::Unit::FEET));
+	}
+	if (const auto temperature = std::get_if<TemperatureGroup>(&groupInfo.group)) {
+		temperatureGroups.push_back(group);
+		temperatureTypes.push_back(static_cast<std::uint8_t>(temperature->type()));
+		push<float>(temperatureAir,
+			temperature->airTemperature().toUnit(Temperature::Unit::C));
+		push<float>(temperatureDewPoints,
+			temperature->dewPoint().toUnit(Temperature::Unit::C));
+	}
+	if (const auto pressure = std::get_if<PressureGroup>(&groupInfo.group)) {
+		pressureGroups.push_back(group);
+		pressureTypes.push_back(static_cast<std::uint8_t>(pressure->type()));
+		push<float>(pressureValues,
+			pressure->atmosphericPressure().toUnit(Pressure::Unit::HECTOPASCAL));
+	}
+}
+
+void SnapshotWriter::clear() {
+	*this = SnapshotWriter();
+}
+
+bool SnapshotWriter::write(std::ostream & output) const {
+	struct ColumnData {
+		SnapshotColumn id;
+		std::uint32_t elementSize;
+		std::size_t count;
+		const void * data;
+	};
+	const auto columnOf = [](SnapshotColumn id, const auto & v, std::size_t elementSize) {
+		return ColumnData{id, static_cast<std::uint32_t>(elementSize),
+			v.size() * sizeof(v[0]) / elementSize, v.data()};
+	};
+	using C = SnapshotColumn;
+	const ColumnData columnData[] = {
+		columnOf(C::REPORT_TYPE, reportTypes, 1),
+		columnOf(C::REPORT_ERROR, reportErrors, 1),
+		columnOf(C::REPORT_FLAGS, reportFlags, 2),
+		columnOf(C::REPORT_LOCATION, reportLocations, 4),
+		columnOf(C::REPORT_TIME, reportTimes, 4),
+		columnOf(C::REPORT_TIME_FROM, reportTimesFrom, 4),
+		columnOf(C::REPORT_TIME_UNTIL, reportTimesUntil, 4),
+		columnOf(C::REPORT_CORRECTION, reportCorrections, 2),
+		columnOf(C::REPORT_TEXT_END, reportTextEnds, 8),
+		columnOf(C::REPORT_TEXT, reportText, 1),
+		columnOf(C::REPORT_GROUP_END, reportGroupEnds, 4),
+		columnOf(C::GROUP_TYPE, groupTypes, 1),
+		columnOf(C::GROUP_PART, groupParts, 1),
+		columnOf(C::GROUP_TEXT_END, groupTextEnds, 8),
+		columnOf(C::GROUP_TEXT, groupText, 1),
+		columnOf(C::WIND_GROUP, windGroups, 4),
+		columnOf(C::WIND_TYPE, windTypes, 1),
+		columnOf(C::WIND_DIRECTION, windDirections, 2),
+		columnOf(C::WIND_SPEED, windSpeeds, 4),
+		columnOf(C::WIND_GUST, windGusts, 4),
+		columnOf(C::VISIBILITY_GROUP, visibilityGroups, 4),
+		columnOf(C::VISIBILITY_TYPE, visibilityTypes, 1),
+		columnOf(C::VISIBILITY_DISTANCE, visibilityDistances, 4),
+		columnOf(C::CLOUD_GROUP, cloudGroups, 4),
+		columnOf(C::CLOUD_TYPE, cloudTypes, 1),
+		columnOf(C::CLOUD_AMOUNT, cloudAmounts, 1),
+		columnOf(C::CLOUD_CONVECTIVE_TYPE, cloudConvectiveTypes, 1),
+		columnOf(C::CLOUD_HEIGHT, cloudHeights, 4),
+		columnOf(C::TEMPERATURE_GROUP, temperatureGroups, 4),
+		columnOf(C::TEMPERATURE_TYPE, temperatureTypes, 1),
+		columnOf(C::TEMPERATURE_AIR, temperatureAir, 4),
+		columnOf(C::TEMPERATURE_DEW_POINT, temperatureDewPoints, 4),
+		columnOf(C::PRESSURE_GROUP, pressureGroups, 4),
+		columnOf(C::PRESSURE_TYPE, pressureTypes, 1),
+		columnOf(C::PRESSURE_VALUE, pressureValues, 4),
+	};
+	const auto columnCount = sizeof(columnData) / sizeof(columnData[0]);
+	const auto aligned = [](std::size_t offset) {
+		return (offset + SnapshotView::alignment - 1) / SnapshotView::alignment *
+			SnapshotView::alignment;
+	};
+
+	SnapshotView::Header header;
+	std::memcpy(header.magic, SnapshotView::magic, sizeof(header.magic));
+	header.formatVersion = SnapshotView::formatVersion;
+	header.byteOrderMark = SnapshotView::byteOrderMark;
+	header.versionMajor = Version::major;
+	header.versionMinor = Version::minor;
+	header.versionPatch = Version::patch;
+	header.columnCount = static_cast<std::uint32_t>(columnCount);
+	header.reportCount = reportCount();
+	header.groupCount = groupCount();
+	output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+	std::size_t offset =
+		aligned(sizeof(header) + columnCount * sizeof(SnapshotView::DirectoryEntry));
+	for (const auto & column : columnData) {
+		const SnapshotView::DirectoryEntry entry = {
+			static_cast<std::uint32_t>(column.id), column.elementSize, offset, column.count
+		};
+		output.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+		offset = aligned(offset + column.count * column.elementSize);
+	}
+
+	static const char padding[SnapshotView::alignment] = {};
+	std::size_t written = sizeof(header) + columnCount * sizeof(SnapshotView::DirectoryEntry);
+	for (const auto & column : columnData) {
+		output.write(padding, aligned(written) - written);
+		written = aligned(written);
+		const auto size = column.count * column.elementSize;
+		output.write(static_cast<const char *>(column.data), size);
+		written += size;
+	}
+	output.write(padding, aligned(written) - written);
+	return static_cast<bool>(output);
+}
+
+std::uint32_t SnapshotWriter::packTime(const std::optional<MetafTime> & time) {
+	if (!time.has_value()) return snapshotMissing<std::uint32_t>();
+	return (time->day().value_or(0) << 16) | (time->hour() << 8) | time->minute();
+}
+
+std::uint32_t SnapshotWriter::row(std::size_t index) {
+	// Group rows are 32-bit, which is plenty for a day of global data
+	if (index >= snapshotMissing<std::uint32_t>())
+		throw std::length_error("Too many groups in snapshot");
+	return static_cast<std::uint32_t>(index);
+}
+
+template <typename T>
+void SnapshotWriter::push(std::vector<T> & column, std::optional<T> value) {
+	column.push_back(value.value_or(snapshotMissing<T>()));
+}
+
+std::optional<SnapshotView> SnapshotView::load(const char * data,
+	std::size_t size,
+	std::string & error)
+{
+	Header header;
+	if (size < sizeof(header)) {
+		error = "not a metaf snapshot (too short)";
+		return std::optional<SnapshotView>();
+	}
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, magic, sizeof(magic))) {
+		error = "not a metaf snapshot";
+		return std::optional<SnapshotView>();
+	}
+	if (header.byteOrderMark != byteOrderMark) {
+		error = "snapshot was written with different byte order";
+		return std::optional<SnapshotView>();
+	}
+	if (header.formatVersion != formatVersion) {
+		error = "unsupported snapshot format version " +
+			std::to_string(header.formatVersion);
+		return std::optional<SnapshotView>();
+	}
+	if (header.versionMajor != static_cast<std::uint32_t>(Version::major) ||
+		header.versionMinor != static_cast<std::uint32_t>(Version::minor) ||
+		header.versionPatch != static_cast<std::uint32_t>(Version::patch))
+	{
+		error = "snapshot was written by metaf " +
+			std::to_string(header.versionMajor) + "." +
+			std::to_string(header.versionMinor) + "." +
+			std::to_string(header.versionPatch);
+		return std::optional<SnapshotView>();
+	}
+	if (reinterpret_cast<std::uintptr_t>(data) % alignment) {
+		error = "snapshot data are not aligned";
+		return std::optional<SnapshotView>();
+	}
+	if (header.columnCount > (size - sizeof(header)) / sizeof(DirectoryEntry)) {
+		error = "snapshot column directory is truncated";
+		return std::optional<SnapshotView>();
+	}
+
+	SnapshotView view;
+	view.reports = header.reportCount;
+	view.groups = header.groupCount;
+	for (std::uint32_t i = 0; i < header.columnCount; i++) {
+		DirectoryEntry entry;
+		std::memcpy(&entry,
+			data + sizeof(header) + i * sizeof(DirectoryEntry),
+			sizeof(entry));
+		// Columns of unknown IDs are ignored
+		if (entry.id > maxColumnId || !entry.elementSize) continue;
+		if (const auto size = elementSize(entry.id); size && entry.elementSize != size) {
+			error = "snapshot column " + std::to_string(entry.id) +
+				" has wrong element size " + std::to_string(entry.elementSize);
+			return std::optional<SnapshotView>();
+		}
+		if (entry.offset % alignment || entry.offset > size ||
+			entry.count > (size - entry.offset) / entry.elementSize)
+		{
+			error = "snapshot column " + std::to_string(entry.id) + " is truncated";
+			return std::optional<SnapshotView>();
+		}
+		auto & column = view.columns[entry.id];
+		column.data = data + entry.offset;
+		column.elementSize = entry.elementSize;
+		column.count = entry.count;
+	}
+
+	// Tables must have as many rows as the header says (group type tables
+	// as many as their column of group rows) and the texts must hold the
+	// last raw string
+	using C = SnapshotColumn;
+	const auto rows = [&](std::initializer_list<C> ids, std::size_t count) {
+		for (const auto id : ids)
+			if (view.columns[static_cast<std::size_t>(id)].count != count) return false;
+		return true;
+	};
+	const auto reportTextEnds = view.column<std::uint64_t>(C::REPORT_TEXT_END);
+	const auto groupTextEnds = view.column<std::uint64_t>(C::GROUP_TEXT_END);
+	const auto groupEnds = view.column<std::uint32_t>(C::REPORT_GROUP_END);
+	if (!rows({C::REPORT_TYPE, C::REPORT_ERROR, C::REPORT_FLAGS, C::REPORT_LOCATION,
+			C::REPORT_TIME, C::REPORT_TIME_FROM, C::REPORT_TIME_UNTIL,
+			C::REPORT_CORRECTION, C::REPORT_TEXT_END, C::REPORT_GROUP_END},
+			view.reports) ||
+		!rows({C::GROUP_TYPE, C::GROUP_PART, C::GROUP_TEXT_END}, view.groups) ||
+		!rows({C::WIND_TYPE, C::WIND_DIRECTION, C::WIND_SPEED, C::WIND_GUST},
+			view.columns[static_cast<std::size_t>(C::WIND_GROUP)].count) ||
+		!rows({C::VISIBILITY_TYPE, C::VISIBILITY_DISTANCE},
+			view.columns[static_cast<std::size_t>(C::VISIBILITY_GROUP)].count) ||
+		!rows({C::CLOUD_TYPE, C::CLOUD_AMOUNT, C::CLOUD_CONVECTIVE_TYPE, C::CLOUD_HEIGHT},
+			view.columns[static_cast<std::size_t>(C::CLOUD_GROUP)].count) ||
+		!rows({C::TEMPERATURE_TYPE, C::TEMPERATURE_AIR, C::TEMPERATURE_DEW_POINT},
+			view.columns[static_cast<std::size_t>(C::TEMPERATURE_GROUP)].count) ||
+		!rows({C::PRESSURE_TYPE, C::PRESSURE_VALUE},
+			view.columns[static_cast<std::size_t>(C::PRESSURE_GROUP)].count) ||
+		(view.reports &&
+			(reportTextEnds[view.reports - 1] > view.column<char>(C::REPORT_TEXT).size() ||
+			groupEnds[view.reports - 1] > view.groups)) ||
+		(view.groups &&
+			groupTextEnds[view.groups - 1] > view.column<char>(C::GROUP_TEXT).size()))
+	{
+		error = "snapshot columns are inconsistent";
+		return std::optional<SnapshotView>();
+	}
+	return view;
+}
+
+bool SnapshotFile::open(const std::string & path, std::string & error) {
+	snapshot.reset();
+	if (!file.open(path, error)) return false;
+	snapshot = SnapshotView::load(file.data(), file.size(), error);
+	if (!snapshot.has_value()) {
+		error = path + ": " + error;
+		file.close();
+		return false;
+	}
+	return true;
+}
+
+std::string_view SnapshotView::location(std::size_t report) const {
+	const auto locations = column<std::array<char, 4>>(SnapshotColumn::REPORT_LOCATION);
+	const auto & location = locations[report];
+	return std::string_view(location.data(),
+		std::find(location.begin(), location.end(), '\0') - location.begin());
+}
+
+std::string_view SnapshotView::rawReport(std::size_t report) const {
+	return textOf(column<std::uint64_t>(SnapshotColumn::REPORT_TEXT_END),
+		column<char>(SnapshotColumn::REPORT_TEXT),
+		report);
+}
+
+std::pair<std::size_t, std::size_t> SnapshotView::groupRange(std::size_t report) const {
+	const auto ends = column<std::uint32_t>(SnapshotColumn::REPORT_GROUP_END);
+	const std::size_t begin = report ? ends[report - 1] : 0;
+	return std::pair(begin, std::max<std::size_t>(begin, ends[report]));
+}
+
+std::string_view SnapshotView::rawGroup(std::size_t group) const {
+	return textOf(column<std::uint64_t>(SnapshotColumn::GROUP_TEXT_END),
+		column<char>(SnapshotColumn::GROUP_TEXT),
+		group);
+}
+
+ReportMetadata SnapshotView::metadata(std::size_t report) const {
+	using C = SnapshotColumn;
+	ReportMetadata result;
+	result.type = reportType(report);
+	result.error = static_cast<ReportError>(column<std::uint8_t>(C::REPORT_ERROR)[report]);
+	result.reportTime = reportTime(report);
+	result.icaoLocation = std::string(location(report));
+	const auto flags = column<std::uint16_t>(C::REPORT_FLAGS)[report];
+	result.isSpeci = flags & SnapshotFlags::SPECI;
+	result.isNospeci = flags & SnapshotFlags::NOSPECI;
+	result.isAutomated = flags & SnapshotFlags::AUTOMATED;
+	result.isAo1 = flags & SnapshotFlags::AO1;
+	result.isAo1a = flags & SnapshotFlags::AO1A;
+	result.isAo2 = flags & SnapshotFlags::AO2;
+	result.isAo2a = flags & SnapshotFlags::AO2A;
+	result.isNil = flags & SnapshotFlags::NIL;
+	result.isCancelled = flags & SnapshotFlags::CANCELLED;
+	result.isAmended = flags & SnapshotFlags::AMENDED;
+	result.isCorrectional = flags & SnapshotFlags::CORRECTIONAL;
+	result.maintenanceIndicator = flags & SnapshotFlags::MAINTENANCE;
+	const auto correction = column<std::uint16_t>(C::REPORT_CORRECTION)[report];
+	result.correctionNumber = (correction == snapshotMissing<std::uint16_t>()) ?
+		std::optional<unsigned int>() : correction;
+	result.timeSpanFrom =
+		unpackTime(column<std::uint32_t>(C::REPORT_TIME_FROM)[report]);
+	result.timeSpanUntil =
+		unpackTime(column<std::uint32_t>(C::REPORT_TIME_UNTIL)[report]);
+	return result;
+}
+
+std::optional<MetafTime> SnapshotView::unpackTime(std::uint32_t packed) {
+	if (packed == snapshotMissing<std::uint32_t>()) return std::optional<MetafTime>();
+	const auto day = packed >> 16;
+	return MetafTime(day ? std::optional<unsigned int>(day) : std::optional<unsigned int>(),
+		(packed >> 8) & 0xFF,
+		packed & 0xFF);
+}
+
+std::string_view SnapshotView::textOf(SnapshotArray<std::uint64_t> ends,
+	SnapshotArray<char> text,
+	std::size_t index)
+{
+	const std::size_t begin = index ? ends[index - 1] : 0;
+	const std::size_t end = ends[index];
+	if (begin >= end || end > text.size()) return std::string_view();
+	return std::string_view(text.begin() + begin, end - begin);
+}
+
+std::size_t SnapshotView::elementSize(std::uint32_t id) {
+	using C = SnapshotColumn;
+	switch (static_cast<C>(id)) {
+		case C::REPORT_TEXT:
+		case C::GROUP_TEXT:
+		return sizeof(char);
+
+		case C::REPORT_TYPE:
+		case C::REPORT_ERROR:
+		case C::GROUP_TYPE:
+		case C::GROUP_PART:
+		case C::WIND_TYPE:
+		case C::VISIBILITY_TYPE:
+		case C::CLOUD_TYPE:
+		case C::CLOUD_AMOUNT:
+		case C::CLOUD_CONVECTIVE_TYPE:
+		case C::TEMPERATURE_TYPE:
+		case C::PRESSURE_TYPE:
+		return sizeof(std::uint8_t);
+
+		case C::REPORT_FLAGS:
+		case C::REPORT_CORRECTION:
+		case C::WIND_DIRECTION:
+		return sizeof(std::uint16_t);
+
+		case C::REPORT_LOCATION:
+		return sizeof(std::array<char, 4>);
+
+		case C::REPORT_TIME:
+		case C::REPORT_TIME_FROM:
+		case C::REPORT_TIME_UNTIL:
+		case C::REPORT_GROUP_END:
+		case C::WIND_GROUP:
+		case C::VISIBILITY_GROUP:
+		case C::CLOUD_GROUP:
+		case C::TEMPERATURE_GROUP:
+		case C::PRESSURE_GROUP:
+		return sizeof(std::uint32_t);
+
+		case C::REPORT_TEXT_END:
+		case C::GROUP_TEXT_END:
+		return sizeof(std::uint64_t);
+
+		case C::WIND_SPEED:
+		case C::WIND_GUST:
+		case C::VISIBILITY_DISTANCE:
+		case C::CLOUD_HEIGHT:
+		case C::TEMPERATURE_AIR:
+		case C::TEMPERATURE_DEW_POINT:
+		case C::PRESSURE_VALUE:
+		return sizeof(float);
+	}
+	return 0;
+}
+
+} //namespace metaf
+
+#endif //#ifndef METAF_SNAPSHOT_HPP